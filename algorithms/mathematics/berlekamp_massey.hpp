@@ -1,40 +1,99 @@
 #ifndef ALGORITHMS_MATHEMATICS_BERLEKAMP_MASSEY_HPP
 #define ALGORITHMS_MATHEMATICS_BERLEKAMP_MASSEY_HPP
 
+#include "algorithms/mathematics/polynomial_gcd"
+
 #include <algorithm>
 #include <vector>
 
+namespace berlekamp_massey_auxiliary {
+
+// Finds c as below, giving up and returning false as soon as it gets longer than max_length.
+// Time complexity: O(N * L).
 template <typename T>
-std::vector<T> berlekamp_massey(const std::vector<T>& s) {
-  std::vector<T> c, b = {0};
+bool naive(const std::vector<T>& s, std::vector<T>& c, int max_length) {
+  // b is the recurrence before the last length change, scaled by the inverse of its discrepancy, and is applied
+  // shifted by m.
+  std::vector<T> b = {0};
+  int m = 0;
+  c.clear();
   for (int i = 0; i < s.size(); ++i) {
     T d = s[i];
     for (int j = 0; j < c.size(); ++j) {
       d -= c[j] * s[i - 1 - j];
     }
-    bool length_change = false;
-    std::vector<T> nb;
-    if (d != 0) {
-      if (c.size() < b.size()) {
-        length_change = true;
-        nb = c;
-        c.insert(c.end(), b.size() - c.size(), 0);
+    if (d == 0) {
+      ++m;
+      continue;
+    }
+    if (c.size() < b.size() + m) {
+      if (b.size() + m > max_length) {
+        return false;
       }
+      auto nb = c;
+      c.resize(b.size() + m);
       for (int j = 0; j < b.size(); ++j) {
-        c[j] += d * b[j];
+        c[j + m] += d * b[j];
       }
-    }
-    if (length_change) {
       T inv = 1 / d;
+      b.resize(nb.size() + 1);
+      b[0] = inv;
       for (int j = 0; j < nb.size(); ++j) {
-        nb[j] *= -inv;
+        b[j + 1] = -inv * nb[j];
       }
-      nb.insert(nb.begin(), inv);
-      std::swap(b, nb);
+      m = 0;
     } else {
-      b.insert(b.begin(), 0);
+      for (int j = 0; j < b.size(); ++j) {
+        c[j + m] += d * b[j];
+      }
+      ++m;
     }
   }
+  return true;
+}
+
+}  // namespace berlekamp_massey_auxiliary
+
+// Returns the shortest c such that s[i] = c[0] * s[i - 1] + ... + c[L - 1] * s[i - L] for L <= i < s.size().
+// Time complexity: O(N * L).
+template <typename T>
+std::vector<T> naive_berlekamp_massey(const std::vector<T>& s) {
+  std::vector<T> c;
+  berlekamp_massey_auxiliary::naive(s, c, s.size());
+  return c;
+}
+
+// Same as above, reading the recurrence off the Pade approximant of the generating function S of s: the half-gcd of
+// x^N and S stops at the remainder r = v * S mod x^N of degree < ceil(N / 2), and v is the connection polynomial of
+// length max(deg(v), deg(r) + 1). When v(0) = 0 no recurrence of that length exists and the quadratic version is used.
+// Short recurrences are still found faster by the quadratic version, which is tried first up to max_naive_length.
+// Time complexity: O(convolution(N) * log(N)).
+template <typename T>
+std::vector<T> berlekamp_massey(const std::vector<T>& s) {
+  constexpr int naive_threshold = 4096, max_naive_length = 1024;
+  using F = FormalPowerSeries<T>;
+  int N = s.size();
+  std::vector<T> c;
+  if (berlekamp_massey_auxiliary::naive(s, c, N <= naive_threshold ? N : max_naive_length)) {
+    return c;
+  }
+  F a(N + 1), b(s.begin(), s.end());
+  a[N] = 1;
+  b.trim_right();
+  std::vector<std::pair<int, T>> quotients;
+  auto M = polynomial_gcd_auxiliary::half_gcd(a, b, quotients);
+  F& v = M[3];
+  if (v[0] == 0) {
+    return naive_berlekamp_massey(s);
+  }
+  F r = polynomial_gcd_auxiliary::multiply(v, b);
+  r.resize(std::min<int>(r.size(), N));
+  r.trim_right();
+  c.assign(std::max<int>(v.size() - 1, r.size()), 0);
+  T inv = -1 / v[0];
+  for (int j = 0; j + 1 < v.size(); ++j) {
+    c[j] = inv * v[j + 1];
+  }
   return c;
 }
 
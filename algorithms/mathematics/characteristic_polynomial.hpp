@@ -6,109 +6,85 @@
 
 namespace characteristic_polynomial_auxiliary {
 
+// Returns a matrix similar to A in upper Hessenberg form, stored row by row: entry (i, j) is at i * N + j.
+// Time complexity: O(N^3).
 template <typename T>
-std::vector<std::vector<T>> upper_hessenberg_form(std::vector<std::vector<T>> A) {
+std::vector<T> upper_hessenberg_form(const std::vector<std::vector<T>>& A) {
   int N = A.size();
+  std::vector<T> H(N * N), c(N);
+  for (int i = 0; i < N; ++i) {
+    std::copy(A[i].begin(), A[i].end(), H.begin() + i * N);
+  }
   for (int i = 0; i + 2 < N; ++i) {
     int pivot = -1;
     for (int j = i + 1; j < N; ++j) {
-      if (A[j][i] != 0) {
+      if (H[j * N + i] != 0) {
         pivot = j;
         break;
       }
     }
     if (pivot == -1) continue;
-    std::swap(A[i + 1], A[pivot]);
-    for (int j = 0; j < N; ++j) {
-      std::swap(A[j][i + 1], A[j][pivot]);
+    if (pivot != i + 1) {
+      std::swap_ranges(H.begin() + (i + 1) * N, H.begin() + (i + 2) * N, H.begin() + pivot * N);
+      for (int j = 0; j < N; ++j) {
+        std::swap(H[j * N + i + 1], H[j * N + pivot]);
+      }
     }
+    // The eliminations below all commute, so the row operations are done first and the column operations are then
+    // gathered into one pass over the rows.
+    T inv = 1 / H[(i + 1) * N + i];
     for (int j = i + 2; j < N; ++j) {
-      if (A[j][i] == 0) continue;
-      T c = A[j][i] / A[i + 1][i];
+      c[j] = H[j * N + i] * inv;
+      if (c[j] == 0) continue;
       for (int k = i; k < N; ++k) {
-        A[j][k] -= c * A[i + 1][k];
-      }
-      for (int k = 0; k < N; ++k) {
-        A[k][i + 1] += c * A[k][j];
+        H[j * N + k] -= c[j] * H[(i + 1) * N + k];
       }
     }
-  }
-  return A;
-}
-
-template <typename T>
-T determinant_of_hessenberg(std::vector<std::vector<T>> A) {
-  if (A.empty()) {
-    return {1};
-  }
-  int N = A[0].size();
-  T det = 1;
-  for (int i = 0; i < N; ++i) {
-    if (A[i][i] == 0) {
-      det *= -1;
-      if (i + 1 == N || A[i + 1][i] == 0) {
-        return 0;
+    for (int k = 0; k < N; ++k) {
+      T sum = 0;
+      for (int j = i + 2; j < N; ++j) {
+        sum += c[j] * H[k * N + j];
       }
-      std::swap(A[i], A[i + 1]);
-    }
-    det *= A[i][i];
-    if (i + 1 < N) {
-      T c = A[i + 1][i] / A[i][i];
-      for (int j = i; j < N; ++j) {
-        A[i + 1][j] -= c * A[i][j];
-      }
-    }
-  }
-  return det;
-}
-
-template <typename T>
-std::vector<T> convolution(const std::vector<T>& p, const std::vector<T>& q) {
-  int N = p.size(), M = q.size();
-  std::vector<T> r(N + M - 1);
-  for (int i = 0; i < N; ++i) {
-    for (int j = 0; j < M; ++j) {
-      r[i + j] += p[i] * q[j];
+      H[k * N + i + 1] += sum;
     }
   }
-  return r;
-}
-
-template <typename T>
-std::vector<T> polynomial_interpolation(const std::vector<T>& y) {
-  std::vector<T> p = {y[0]}, f = {1};
-  for (int i = 1; i < y.size(); ++i) {
-    T inv = T(1) / T(i);
-    f = convolution({-(1 - inv), inv}, f);
-    T v = y[i], pow = 1;
-    for (auto a : p) {
-      v -= a * pow;
-      pow *= i;
-    }
-    p.push_back(0);
-    for (int j = 0; j < p.size(); ++j) {
-      p[j] += v * f[j];
-    }
-  }
-  return p;
+  return H;
 }
 
 }  // namespace characteristic_polynomial_auxiliary
 
+// Returns det(xI - A), from the characteristic polynomials p[k] of the leading k x k blocks of the Hessenberg form H:
+// p[k + 1] = (x - H[k][k]) p[k] - sum over i < k of H[i][k] H[i + 1][i] ... H[k][k - 1] p[i].
+// Time complexity: O(N^3).
 template <typename T>
-std::vector<T> characteristic_polynomial(std::vector<std::vector<T>> A) {
+std::vector<T> characteristic_polynomial(const std::vector<std::vector<T>>& A) {
   namespace aux = characteristic_polynomial_auxiliary;
   int N = A.size();
-  A = aux::upper_hessenberg_form(std::move(A));
-  std::vector<T> y(N + 1);
-  for (int i = 0; i <= N; ++i) {
-    T det = aux::determinant_of_hessenberg(A);
-    y[i] = N % 2 ? -det : det;
-    for (int j = 0; j < N; ++j) {
-      A[j][j] -= 1;
+  auto H = aux::upper_hessenberg_form(A);
+  // p[k] has k + 1 coefficients starting at k * (k + 1) / 2.
+  std::vector<T> p((N + 1) * (N + 2) / 2);
+  p[0] = 1;
+  for (int k = 0; k < N; ++k) {
+    const T* prev = p.data() + k * (k + 1) / 2;
+    T* cur = p.data() + (k + 1) * (k + 2) / 2;
+    T h = H[k * N + k];
+    for (int j = 0; j <= k; ++j) {
+      cur[j + 1] += prev[j];
+      cur[j] -= h * prev[j];
+    }
+    T t = 1;
+    for (int i = k - 1; i >= 0; --i) {
+      t *= H[(i + 1) * N + i];
+      if (t == 0) break;
+      T c = t * H[i * N + k];
+      if (c == 0) continue;
+      const T* q = p.data() + i * (i + 1) / 2;
+      for (int j = 0; j <= i; ++j) {
+        cur[j] -= c * q[j];
+      }
     }
   }
-  return aux::polynomial_interpolation(y);
+  return std::vector<T>(p.end() - (N + 1), p.end());
 }
 
 #endif  // ALGORITHMS_MATHEMATICS_CHARACTERISTIC_POLYNOMIAL_HPP
@@ -4,29 +4,80 @@
 #include "algorithms/mathematics/combinatorics"
 #include "algorithms/mathematics/modular_arithmetic"
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
 
+// Tables grow on demand by a factor of 1.5, or up to the largest n requested. Each range [2^(b - 1), 2^b) is split into
+// four blocks that are allocated as they are reached, so a table of size N takes at most 1.25N entries. Blocks are
+// never moved once written, so readers only need an acquire load of the current size and are safe to run
+// concurrently with a growing thread.
 template <unsigned P>
 struct Combinatorics<Z<P>> {
-  static const Combinatorics<Z<P>>& get_instance() {
-    static Combinatorics<Z<P>> C(1 << 20);
+  struct Entry {
+    Z<P> fact, rfact, rec;
+  };
+
+  static Combinatorics& get_instance() {
+    static Combinatorics C;
     return C;
   }
 
-  std::vector<Z<P>> fact, rfact, rec;
+  std::atomic<int> N{0};
+  std::mutex mutex;
+  std::unique_ptr<Entry[]> blocks[32][4];
+
+  static int block(int n) {
+    return n ? 32 - __builtin_clz(n) : 0;
+  }
+
+  const Entry& at(int n) const {
+    int b = block(n), s = b > 3 ? b - 3 : 0, o = n - ((1 << b) >> 1);
+    return blocks[b][o >> s][o & ((1 << s) - 1)];
+  }
+
+  // Amortized time complexity: O(1).
+  const Entry& entry(int n) {
+    if (n >= N.load(std::memory_order_acquire)) {
+      grow(n);
+    }
+    return at(n);
+  }
 
-  Combinatorics(int N) : fact(N), rfact(N), rec(N) {
-    fact[0] = fact[1] = rfact[0] = rfact[1] = rec[1] = 1;
-    for (int i = 2; i < N; ++i) {
-      rec[i] = -(P / i * rec[P % i]);
-      rfact[i] = rec[i] * rfact[i - 1];
-      fact[i] = i * fact[i - 1];
+  void grow(int n) {
+    assert(0 <= n && (unsigned)n < P);
+    std::lock_guard<std::mutex> lock(mutex);
+    int M = N.load(std::memory_order_relaxed);
+    if (n < M) return;
+    int K = std::min<long long>(P, std::max<long long>(n + 1, M + M / 2));
+    for (int i = M; i < K; ++i) {
+      int b = block(i), s = b > 3 ? b - 3 : 0, o = i - ((1 << b) >> 1);
+      if ((o & ((1 << s) - 1)) == 0) {
+        blocks[b][o >> s].reset(new Entry[1 << s]);
+      }
+      auto& e = blocks[b][o >> s][o & ((1 << s) - 1)];
+      if (i < 2) {
+        e.fact = e.rfact = e.rec = 1;
+      } else {
+        e.rec = -(P / i * at(P % i).rec);
+        e.rfact = e.rec * at(i - 1).rfact;
+        e.fact = i * at(i - 1).fact;
+      }
     }
+    N.store(K, std::memory_order_release);
+  }
+
+  // Makes sure the tables hold every index up to n.
+  static void reserve(int n) {
+    get_instance().entry(n);
   }
 
   static Z<P> C(int n, int k) {
-    const auto& comb = get_instance();
-    return k < 0 || n < k ? 0 : k == 0 || k == n ? 1 : comb.fact[n] * comb.rfact[k] * comb.rfact[n - k];
+    if (k < 0 || n < k) return 0;
+    auto& comb = get_instance();
+    return comb.entry(n).fact * comb.entry(k).rfact * comb.entry(n - k).rfact;
   }
 
   static Z<P> S(int n, int k) {
@@ -34,15 +85,15 @@ struct Combinatorics<Z<P>> {
   }
 
   static Z<P> f(int n) {
-    return get_instance().fact[n];
+    return get_instance().entry(n).fact;
   }
 
   static Z<P> rf(int n) {
-    return get_instance().rfact[n];
+    return get_instance().entry(n).rfact;
   }
 
   static Z<P> r(int n) {
-    return get_instance().rec[n];
+    return get_instance().entry(n).rec;
   }
 };
 
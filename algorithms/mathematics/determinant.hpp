@@ -1,39 +1,76 @@
 #ifndef ALGORITHMS_MATHEMATICS_DETERMINANT_HPP
 #define ALGORITHMS_MATHEMATICS_DETERMINANT_HPP
 
+#include "algorithms/mathematics/gaussian_elimination"
 #include "algorithms/mathematics/matrix"
 
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
+#include <vector>
 
+// Fraction-free elimination: after step k every entry is a (k + 1) x (k + 1) minor of A, so all divisions are exact
+// and T only needs to hold those minors and products of two of them.
+// Time complexity: O(N^3).
 template <typename T>
-T determinant(Matrix<T> A) {
-  int N = A.size();
-  assert(N == A[0].size());
-  T det = 1;
-  for (int x = 0; x < N; ++x) {
-    int sel = -1;
-    for (int i = x; i < N; ++i) {
-      if (A[i][x] != 0) {
-        sel = i;
-        break;
+T bareiss_determinant(DenseMatrix<T> A) {
+  int N = A.N;
+  assert(N == A.M);
+  T prev = 1, sign = 1;
+  for (int k = 0; k < N; ++k) {
+    if (A[k][k] == 0) {
+      int sel = -1;
+      for (int i = k + 1; i < N; ++i) {
+        if (A[i][k] != 0) {
+          sel = i;
+          break;
+        }
       }
+      if (sel == -1) return 0;
+      std::swap_ranges(A[sel] + k, A[sel] + N, A[k] + k);
+      sign = -sign;
     }
-    if (sel == -1) return 0;
-    if (sel != x) {
-      std::swap(A[sel], A[x]);
-      det *= -1;
+    for (int i = k + 1; i < N; ++i) {
+      for (int j = k + 1; j < N; ++j) {
+        A[i][j] = (A[i][j] * A[k][k] - A[i][k] * A[k][j]) / prev;
+      }
+    }
+    prev = A[k][k];
+  }
+  return N ? sign * A[N - 1][N - 1] : T(1);
+}
+
+// Product of the pivots of PA = LU, with the sign of P. Integer types go through bareiss_determinant.
+// Time complexity: O(N^3).
+template <typename T>
+T determinant(const DenseMatrix<T>& A) {
+  assert(A.N == A.M);
+  if constexpr (std::is_integral_v<T>) {
+    return bareiss_determinant(A);
+  } else {
+    int N = A.N;
+    GaussianElimination<T> ge(A);
+    if (ge.rank < N) return 0;
+    T det = 1;
+    for (int i = 0; i < N; ++i) {
+      det *= ge.LU[i][i];
     }
-    det *= A[x][x];
+    std::vector<bool> visited(N);
     for (int i = 0; i < N; ++i) {
-      if (i == x) continue;
-      T c = A[i][x] / A[x][x];
-      for (int j = x; j < N; ++j) {
-        A[i][j] -= c * A[x][j];
+      if (visited[i]) continue;
+      for (int j = ge.perm[i]; j != i; j = ge.perm[j]) {
+        visited[j] = true;
+        det = -det;
       }
+      visited[i] = true;
     }
+    return det;
   }
-  return det;
+}
+
+template <typename T>
+T determinant(const Matrix<T>& A) {
+  return determinant(DenseMatrix<T>(A));
 }
 
 #endif  // ALGORITHMS_MATHEMATICS_DETERMINANT_HPP
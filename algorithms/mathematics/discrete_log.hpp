@@ -1,42 +1,180 @@
 #ifndef ALGORITHMS_MATHEMATICS_DISCRETE_LOG_HPP
 #define ALGORITHMS_MATHEMATICS_DISCRETE_LOG_HPP
 
+#include "algorithms/mathematics/crt"
+#include "algorithms/mathematics/extended_gcd"
+#include "algorithms/mathematics/factorization"
+
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <numeric>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
-// Returns minimum x such that a^x = b (-1 if there is none).
-// Time complexity: O(sqrt(mod)).
-long long discrete_log(long long a, long long b, long long mod) {
-  assert(0 <= a < mod);
-  assert(0 <= b < mod);
-  long long k = 1, add = 0;
-  while (true) {
-    long long g = std::gcd(a, mod);
-    if (g == 1) break;
-    if (b == k) return add;
-    if (b % g) return -1;
-    b /= g;
-    mod /= g;
-    k = k * a / g % mod;
-    ++add;
+namespace discrete_log_auxiliary {
+
+inline long long mul(long long a, long long b, long long mod) {
+  return (__int128)a * b % mod;
+}
+
+inline long long pow(long long a, long long n, long long mod) {
+  long long res = 1 % mod;
+  for (; n; n >>= 1, a = mul(a, a, mod)) {
+    if (n & 1) res = mul(res, a, mod);
+  }
+  return res;
+}
+
+inline long long inverse(long long a, long long mod) {
+  long long x, y;
+  extended_gcd(a, mod, x, y);
+  return (x % mod + mod) % mod;
+}
+
+// Open addressing with linear probing for at most capacity keys, each mapped to the value inserted first.
+struct HashTable {
+  static constexpr unsigned long long empty = -1;
+
+  int shift;
+  std::vector<unsigned long long> keys;
+  std::vector<int> values;
+
+  explicit HashTable(int capacity) : shift(64) {
+    int size = 1;
+    while (size < 2 * capacity) {
+      size *= 2, --shift;
+    }
+    keys.assign(size, empty);
+    values.resize(size);
   }
-  long long d = 1 + sqrtl(mod);
-  std::unordered_map<long long, int> small;
-  long long x = 1;
-  for (int i = 1; i <= d; ++i) {
-    x = x * a % mod;
-    small[b * x % mod] = i;
+
+  int slot(unsigned long long key) const {
+    return shift == 64 ? 0 : key * 0x9e3779b97f4a7c15ULL >> shift;
   }
-  long long y = k;
-  for (int i = 1; i <= d; ++i) {
-    y = y * x % mod;
-    if (small.count(y)) {
-      return i * d - small[y] + add;
+
+  void insert(unsigned long long key, int value) {
+    int i = slot(key);
+    for (; keys[i] != empty; i = (i + 1) & (keys.size() - 1)) {
+      if (keys[i] == key) return;
     }
+    keys[i] = key, values[i] = value;
   }
-  return -1;
+
+  // Returns -1 if key is absent.
+  int find(unsigned long long key) const {
+    for (int i = slot(key); keys[i] != empty; i = (i + 1) & (keys.size() - 1)) {
+      if (keys[i] == key) return values[i];
+    }
+    return -1;
+  }
+};
+
+}  // namespace discrete_log_auxiliary
+
+// Discrete logarithms to a fixed base modulo a fixed modulus. The common factors of the base and the modulus are
+// divided out first, leaving a unit a of order n modulo mod. Then Pohlig-Hellman reduces a query to logarithms in the
+// subgroups of prime order q | n, each found by baby-step giant-step against a table built here once. For q^e || n
+// the table has sqrt(e * q * queries) baby steps, balancing it against the giant steps of the expected queries.
+struct DiscreteLogSolver {
+  struct Subgroup {
+    long long q, q_e, giant;
+    int m;
+    discrete_log_auxiliary::HashTable table;
+  };
+
+  long long modulus, a, mod, k = 1, k_inverse, a_inverse, n;
+  std::vector<long long> divisors, prefixes;
+  std::vector<Subgroup> subgroups;
+
+  // Time complexity: O(modulus^(1/4) + sum of sqrt(e * q * queries) over the q^e || n).
+  DiscreteLogSolver(long long a_, long long modulus_, long long queries = 1)
+      : modulus(modulus_), a(a_ % modulus_), mod(modulus_) {
+    namespace aux = discrete_log_auxiliary;
+    assert(0 <= a);
+    // Before dividing by each g = gcd(a, mod), the answer is the number of steps so far if b = k.
+    for (long long g; (g = std::gcd(a, mod)) != 1;) {
+      divisors.push_back(g);
+      prefixes.push_back(k);
+      mod /= g;
+      k = aux::mul(k, a / g, mod);
+    }
+    a %= mod;
+    k_inverse = aux::inverse(k, mod), a_inverse = aux::inverse(a, mod);
+    std::vector<long long> primes;
+    n = 1;
+    for (auto [p, e] : factorize(mod)) {
+      n *= p - 1;
+      for (int i = 1; i < e; ++i) {
+        n *= p;
+      }
+      primes.push_back(p);
+      for (auto [r, f] : factorize(p - 1)) {
+        primes.push_back(r);
+      }
+    }
+    std::sort(primes.begin(), primes.end());
+    primes.erase(std::unique(primes.begin(), primes.end()), primes.end());
+    for (long long q : primes) {
+      while (n % q == 0 && aux::pow(a, n / q, mod) == 1) {
+        n /= q;
+      }
+    }
+    for (long long q : primes) {
+      if (n % q) continue;
+      int e = 0;
+      long long q_e = 1;
+      for (; n / q_e % q == 0; q_e *= q) {
+        ++e;
+      }
+      int m = std::min<long double>(q, std::ceil(std::sqrt((long double)e * q * std::max(queries, 1LL))));
+      aux::HashTable table(m);
+      long long gamma = aux::pow(a, n / q, mod), z = 1;
+      for (int j = 0; j < m; ++j, z = aux::mul(z, gamma, mod)) {
+        table.insert(z, j);
+      }
+      subgroups.push_back({q, q_e, aux::pow(aux::pow(a_inverse, n / q, mod), m, mod), m, std::move(table)});
+    }
+  }
+
+  // Returns the minimum x with base^x = b modulo modulus (-1 if there is none). The digits of x in base q modulo q^e
+  // are found one at a time in the subgroup of order q, and the residues are combined by CRT.
+  // Time complexity: O(sum of e * (q / m + log(n)) over the subgroups).
+  long long solve(long long b) const {
+    namespace aux = discrete_log_auxiliary;
+    assert(0 <= b);
+    b %= modulus;
+    for (int i = 0; i < divisors.size(); ++i) {
+      if (b == prefixes[i]) return i;
+      if (b % divisors[i]) return -1;
+      b /= divisors[i];
+    }
+    if (mod == 1) return divisors.size();
+    b = aux::mul(b, k_inverse, mod);
+    if (aux::pow(b, n, mod) != 1) return -1;
+    CRT<__int128> x;
+    for (auto& [q, q_e, giant, m, table] : subgroups) {
+      long long alpha = aux::pow(a_inverse, n / q_e, mod), beta = aux::pow(b, n / q_e, mod), y = 0;
+      // beta is b^(n / q^e) a^(-y n / q^e) and alpha is a^(-r n / q^e).
+      for (long long r = 1; r < q_e; r *= q, alpha = aux::pow(alpha, q, mod)) {
+        long long h = aux::pow(beta, q_e / r / q, mod), d = -1;
+        for (long long i = 0; i * m < q && d == -1; ++i, h = aux::mul(h, giant, mod)) {
+          if (int j = table.find(h); j != -1) d = i * m + j;
+        }
+        if (d == -1) return -1;
+        y += d * r;
+        beta = aux::mul(beta, aux::pow(alpha, d, mod), mod);
+      }
+      x = x + CRT<__int128>(y, q_e);
+    }
+    return x.a + divisors.size();
+  }
+};
+
+// Returns minimum x such that a^x = b (-1 if there is none).
+// Time complexity: O(sqrt(mod)).
+inline long long discrete_log(long long a, long long b, long long mod) {
+  return DiscreteLogSolver(a, mod).solve(b);
 }
 
 #endif  // ALGORITHMS_MATHEMATICS_DISCRETE_LOG_HPP
@@ -1,43 +1,144 @@
 #ifndef ALGORITHMS_MATHEMATICS_DISCRETE_SQRT_HPP
 #define ALGORITHMS_MATHEMATICS_DISCRETE_SQRT_HPP
 
-#include <chrono>
-#include <random>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "algorithms/mathematics/modular_arithmetic"
 
+namespace discrete_sqrt_auxiliary {
+
+// Tonelli-Shanks for P - 1 = 2^s q with q odd. With c = z^q for a non-residue z, which generates the subgroup of order
+// 2^s, a^q = c^e for some e that is even exactly when a is a square, and then a^((q + 1) / 2) c^(-e / 2) is a root.
+// e is found bits digits at a time from the bottom by looking up the log of a power of a^q c^(-(e mod 2^(bits j)))
+// in the subgroup of order 2^bits.
 template <unsigned P>
-std::pair<bool, Z<P>> sqrt(Z<P> alpha) {
-  if (pow(alpha, (P - 1) / 2) != 1) {
-    return {false, 0};  // failed
+struct TonelliShanks {
+  static constexpr int max_bits = 8;
+
+  int s = 0, bits, shift;
+  unsigned q = P - 1;
+  // c_inverse[j << bits | d] = c^(-d 2^(bits j)).
+  std::vector<Z<P>> c_inverse;
+  // Open addressing table of g^d for g = c^(2^(s - bits)) and d < 2^bits, with 0 for empty slots.
+  std::vector<unsigned> keys, logs;
+
+  TonelliShanks() {
+    for (; q % 2 == 0; q /= 2) {
+      ++s;
+    }
+    bits = std::min(s, max_bits);
+    if (s == 0) return;
+    Z<P> z = 2;
+    while (pow(z, (P - 1) / 2) != -1) {
+      z += 1;
+    }
+    Z<P> c = pow(z, q), g = c;
+    for (int i = 0; i < s - bits; ++i) {
+      g *= g;
+    }
+    int digits = (s + bits - 1) / bits;
+    c_inverse.resize(digits << bits);
+    Z<P> b = 1 / c;
+    for (int j = 0; j < digits; ++j) {
+      c_inverse[j << bits] = 1;
+      for (int d = 1; d < 1 << bits; ++d) {
+        c_inverse[j << bits | d] = c_inverse[j << bits | (d - 1)] * b;
+      }
+      for (int i = 0; i < bits; ++i) {
+        b *= b;
+      }
+    }
+    shift = 32 - (bits + 2);
+    keys.assign(4 << bits, 0);
+    logs.resize(4 << bits);
+    Z<P> x = 1;
+    for (unsigned d = 0; d < 1 << bits; ++d, x *= g) {
+      unsigned i = slot(x.value);
+      while (keys[i]) {
+        i = (i + 1) & (keys.size() - 1);
+      }
+      keys[i] = x.value, logs[i] = d;
+    }
   }
-  static Z<P> alpha_;
-  alpha_ = alpha;
-  struct R {
-    Z<P> a, b;
-    R operator*(const R& rhs) const {
-      return R{a * rhs.a + alpha_ * b * rhs.b, a * rhs.b + b * rhs.a};
+
+  unsigned slot(unsigned key) const {
+    return key * 0x9e3779b1U >> shift;
+  }
+
+  // Returns d with g^d = u, for u in the subgroup of order 2^bits.
+  unsigned log(Z<P> u) const {
+    unsigned i = slot(u.value);
+    while (keys[i] != u.value) {
+      i = (i + 1) & (keys.size() - 1);
     }
-  };
-  std::uniform_int_distribution<unsigned> unif(0, P - 1);
-  while (true) {
-    static std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
-    Z<P> y = unif(rng);
-    if (y * y == alpha) {
-      return {true, y};
-    }
-    auto x = R{y, 1};
-    R pow{1, 0};
-    for (int p = (P - 1) / 2; p; p >>= 1) {
-      if (p & 1) {
-        pow = pow * x;
+    return logs[i];
+  }
+
+  std::pair<bool, Z<P>> operator()(Z<P> a) const {
+    if (a == 0 || s == 0) return {true, a};
+    Z<P> r = pow(a, (q - 1) / 2), x = r * a, w = r * x;
+    unsigned e = 0;
+    for (int j = 0; j * bits < s; ++j) {
+      int b = std::min(bits, s - j * bits);
+      Z<P> u = w;
+      for (int i = 0; i < s - j * bits - b; ++i) {
+        u *= u;
       }
-      x = x * x;
+      unsigned d = log(u) >> (bits - b);
+      e |= d << (j * bits);
+      w *= c_inverse[j << bits | d];
     }
-    if (pow.b != 0) {
-      return {true, 1 / pow.b};
+    if (e & 1) return {false, 0};
+    e >>= 1;
+    for (int j = 0; e; ++j, e >>= bits) {
+      x *= c_inverse[j << bits | (e & ((1 << bits) - 1))];
+    }
+    return {true, x};
+  }
+};
+
+// Built once per modulus, on first use, and only read afterwards.
+template <unsigned P>
+const TonelliShanks<P>& tonelli_shanks() {
+  static const TonelliShanks<P> t;
+  return t;
+}
+
+}  // namespace discrete_sqrt_auxiliary
+
+// Returns whether alpha is a square, and a square root of it if so. P must be prime.
+// Time complexity: O(log(P) + s^2 / bits), where 2^s || P - 1.
+template <unsigned P>
+std::pair<bool, Z<P>> sqrt(Z<P> alpha) {
+  return discrete_sqrt_auxiliary::tonelli_shanks<P>()(alpha);
+}
+
+// Same as above for each entry of alpha, split over threads.
+template <unsigned P>
+std::vector<std::pair<bool, Z<P>>> sqrt(const std::vector<Z<P>>& alpha,
+                                        int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  const auto& t = discrete_sqrt_auxiliary::tonelli_shanks<P>();
+  int N = alpha.size();
+  threads = std::max(1, std::min(threads, N >> 12));
+  std::vector<std::pair<bool, Z<P>>> res(N);
+  auto run = [&](int l, int r) {
+    for (int i = l; i < r; ++i) {
+      res[i] = t(alpha[i]);
     }
+  };
+  std::vector<std::future<void>> futures;
+  for (int i = 1; i < threads; ++i) {
+    futures.push_back(std::async(std::launch::async, run, (long long)N * i / threads, (long long)N * (i + 1) / threads));
+  }
+  run(0, N / threads);
+  for (auto& future : futures) {
+    future.get();
   }
+  return res;
 }
 
 #endif  // ALGORITHMS_MATHEMATICS_DISCRETE_SQRT_HPP
@@ -38,7 +38,7 @@ std::vector<T> partition_function(int N) {
   FormalPowerSeries<T> f(N + 1);
   for (int k = 1; k <= N; ++k) {
     for (int l = 1; l * k <= N; ++l) {
-      f[l * k] += Combinatorics<T>::get_instance().r[l];
+      f[l * k] += Combinatorics<T>::r(l);
     }
   }
   return exp(f);
@@ -0,0 +1,163 @@
+#ifndef ALGORITHMS_MATHEMATICS_FACTORIZATION_HPP
+#define ALGORITHMS_MATHEMATICS_FACTORIZATION_HPP
+
+#include "algorithms/mathematics/montgomery"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace factorization_auxiliary {
+
+using u64 = unsigned long long;
+
+constexpr int small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61};
+
+// Miller-Rabin for odd n > 61 with the bases that decide every n < 2^64.
+inline bool miller_rabin(u64 n) {
+  Montgomery M(n);
+  int s = __builtin_ctzll(n - 1);
+  u64 d = (n - 1) >> s, one = M.one(), minus_one = M.sub(0, one);
+  for (u64 a : {2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL}) {
+    if (a % n == 0) continue;
+    u64 x = M.pow(M.transform(a), d);
+    if (x == one || x == minus_one) continue;
+    int i = 1;
+    for (; i < s && x != minus_one; ++i) {
+      x = M.mul(x, x);
+    }
+    if (x != minus_one) return false;
+  }
+  return true;
+}
+
+// Returns a nontrivial factor of the odd composite n by Pollard's rho with Brent's cycle detection. The differences
+// are multiplied together in batches of batch_size and only their product is passed to gcd, stepping back through
+// the last batch when it hits n at once.
+inline u64 pollard_brent(u64 n) {
+  constexpr int batch_size = 128;
+  Montgomery M(n);
+  auto diff = [](u64 x, u64 y) { return x > y ? x - y : y - x; };
+  for (u64 c = M.one();; c = M.add(c, M.one())) {
+    auto f = [&](u64 x) { return M.add(M.mul(x, x), c); };
+    u64 x, y = M.transform(2), ys, q = M.one(), g = 1;
+    for (long long r = 1; g == 1; r *= 2) {
+      x = y;
+      for (long long i = 0; i < r; ++i) {
+        y = f(y);
+      }
+      for (long long k = 0; k < r && g == 1; k += batch_size) {
+        ys = y;
+        for (long long i = 0; i < std::min<long long>(batch_size, r - k); ++i) {
+          y = f(y);
+          q = M.mul(q, diff(x, y));
+        }
+        g = std::gcd(q, n);
+      }
+    }
+    if (g == n) {
+      do {
+        ys = f(ys);
+        g = std::gcd(diff(x, ys), n);
+      } while (g == 1);
+    }
+    if (g != n) return g;
+  }
+}
+
+}  // namespace factorization_auxiliary
+
+// Deterministic for every n < 2^64.
+// Time complexity: O(log(n)) multiplications.
+inline bool is_prime(unsigned long long n) {
+  for (int p : factorization_auxiliary::small_primes) {
+    if (n % p == 0) return n == p;
+  }
+  return n > 1 && (n < 67 * 67 || factorization_auxiliary::miller_rabin(n));
+}
+
+namespace factorization_auxiliary {
+
+inline void factorize(u64 n, std::vector<u64>& primes) {
+  if (n == 1) return;
+  if (is_prime(n)) {
+    primes.push_back(n);
+    return;
+  }
+  u64 d = pollard_brent(n);
+  factorize(d, primes);
+  factorize(n / d, primes);
+}
+
+}  // namespace factorization_auxiliary
+
+// Returns the prime factors of n in increasing order with their exponents. Small primes are divided out first and the
+// rest is split by Pollard-Brent.
+// Time complexity: O(n^(1/4)) expected multiplications.
+inline std::vector<std::pair<unsigned long long, int>> factorize(unsigned long long n) {
+  namespace aux = factorization_auxiliary;
+  assert(n > 0);
+  std::vector<unsigned long long> primes;
+  for (int p : aux::small_primes) {
+    for (; n % p == 0; n /= p) {
+      primes.push_back(p);
+    }
+  }
+  aux::factorize(n, primes);
+  std::sort(primes.begin(), primes.end());
+  std::vector<std::pair<unsigned long long, int>> res;
+  for (auto p : primes) {
+    if (res.empty() || res.back().first != p) {
+      res.emplace_back(p, 0);
+    }
+    ++res.back().second;
+  }
+  return res;
+}
+
+// Returns the divisors of n in increasing order.
+inline std::vector<unsigned long long> divisors(unsigned long long n) {
+  assert(n > 0);
+  std::vector<unsigned long long> res = {1};
+  for (auto [p, e] : factorize(n)) {
+    int size = res.size();
+    unsigned long long q = 1;
+    for (int i = 0; i < e; ++i) {
+      q *= p;
+      for (int j = 0; j < size; ++j) {
+        res.push_back(res[j] * q);
+      }
+    }
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+// Returns the smallest primitive root modulo n, or 0 if there is none. Only 2, 4, p^k and 2p^k have one, and modulo
+// 2p^k the roots are the odd roots modulo p^k. g is a root modulo p^k when g^(phi / q) != 1 for each prime q | phi.
+// Time complexity: O(n^(1/4)) expected multiplications for the factorization, and O(log(n)^2) per candidate.
+inline unsigned long long primitive_root(unsigned long long n) {
+  assert(n > 0);
+  if (n <= 4) return n == 1 ? 0 : n - 1;
+  auto f = factorize(n % 2 ? n : n / 2);
+  if (f.size() != 1 || f[0].first == 2) return 0;
+  auto [p, k] = f[0];
+  unsigned long long m = n % 2 ? n : n / 2, phi = m / p * (p - 1);
+  std::vector<unsigned long long> primes;
+  for (auto [q, e] : factorize(p - 1)) {
+    primes.push_back(q);
+  }
+  if (k > 1) primes.push_back(p);
+  Montgomery M(m);
+  for (unsigned long long g = 2;; ++g) {
+    if (g % p == 0 || (n % 2 == 0 && g % 2 == 0)) continue;
+    unsigned long long x = M.transform(g);
+    if (std::all_of(primes.begin(), primes.end(), [&](auto q) { return M.pow(x, phi / q) != M.one(); })) {
+      return g;
+    }
+  }
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_FACTORIZATION_HPP
@@ -3,9 +3,15 @@
 
 #include "algorithms/mathematics/combinatorics"
 #include "algorithms/mathematics/convolution_base"
+#include "algorithms/mathematics/modular_arithmetic"
 
 #include <algorithm>
-#include <deque>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <queue>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -17,10 +23,6 @@ struct FormalPowerSeries : public std::vector<T> {
   template <typename... Args>
   explicit FormalPowerSeries(Args&&... args) : std::vector<T>(std::forward<Args>(args)...) {}
 
-  F operator+(const F& rhs) const {
-    return F(*this) += rhs;
-  }
-
   F& operator+=(const F& rhs) {
     if (this->size() < rhs.size()) {
       this->resize(rhs.size());
@@ -31,10 +33,6 @@ struct FormalPowerSeries : public std::vector<T> {
     return *this;
   }
 
-  F operator-(const F& rhs) const {
-    return F(*this) -= rhs;
-  }
-
   F& operator-=(const F& rhs) {
     if (this->size() < rhs.size()) {
       this->resize(rhs.size());
@@ -45,31 +43,89 @@ struct FormalPowerSeries : public std::vector<T> {
     return *this;
   }
 
-  F operator*(T alpha) const {
-    return F(*this) *= alpha;
+  // The overloads taking a temporary write the result into it instead of allocating a new series.
+  friend F operator+(const F& lhs, const F& rhs) {
+    return F(lhs) += rhs;
   }
 
-  F& operator*=(T alpha) {
-    for (auto& x : *this) {
-      x *= alpha;
+  friend F operator+(F&& lhs, const F& rhs) {
+    return std::move(lhs += rhs);
+  }
+
+  friend F operator+(const F& lhs, F&& rhs) {
+    return std::move(rhs += lhs);
+  }
+
+  friend F operator+(F&& lhs, F&& rhs) {
+    return std::move(lhs += rhs);
+  }
+
+  friend F operator-(const F& lhs, const F& rhs) {
+    return F(lhs) -= rhs;
+  }
+
+  friend F operator-(F&& lhs, const F& rhs) {
+    return std::move(lhs -= rhs);
+  }
+
+  friend F operator-(const F& lhs, F&& rhs) {
+    if (rhs.size() < lhs.size()) {
+      rhs.resize(lhs.size());
     }
-    return *this;
+    for (int i = 0; i < rhs.size(); ++i) {
+      rhs[i] = (i < lhs.size() ? lhs[i] : T(0)) - rhs[i];
+    }
+    return std::move(rhs);
   }
 
-  friend F operator*(T alpha, F rhs) {
-    return rhs *= alpha;
+  friend F operator-(F&& lhs, F&& rhs) {
+    return std::move(lhs -= rhs);
   }
 
-  F operator/(T alpha) const {
-    return F(*this) *= 1 / alpha;
+  friend F operator-(const F& rhs) {
+    return -F(rhs);
   }
 
-  F& operator/=(T alpha) {
-    return *this *= 1 / alpha;
+  friend F operator-(F&& rhs) {
+    for (auto& x : rhs) {
+      x = -x;
+    }
+    return std::move(rhs);
+  }
+
+  friend F operator*(const F& lhs, T alpha) {
+    return F(lhs) *= alpha;
+  }
+
+  friend F operator*(F&& lhs, T alpha) {
+    return std::move(lhs *= alpha);
+  }
+
+  friend F operator*(T alpha, const F& rhs) {
+    return rhs * alpha;
+  }
+
+  friend F operator*(T alpha, F&& rhs) {
+    return std::move(rhs *= alpha);
+  }
+
+  friend F operator/(const F& lhs, T alpha) {
+    return lhs * (1 / alpha);
   }
 
-  F operator-() const {
-    return F() -= *this;
+  friend F operator/(F&& lhs, T alpha) {
+    return std::move(lhs *= 1 / alpha);
+  }
+
+  F& operator*=(T alpha) {
+    for (auto& x : *this) {
+      x *= alpha;
+    }
+    return *this;
+  }
+
+  F& operator/=(T alpha) {
+    return *this *= 1 / alpha;
   }
 
   F operator*(F rhs) const {
@@ -83,8 +139,9 @@ struct FormalPowerSeries : public std::vector<T> {
   std::pair<F, F> naive_division(const F& d) const {
     assert(!d.empty() && d.back() != 0);
     F q, r = *this;
+    T inv = 1 / d.back();
     while (r.size() >= d.size()) {
-      T c = r.back() / d.back();
+      T c = r.back() * inv;
       q.push_back(c);
       for (int i = 0; i < d.size(); ++i) {
         r.rbegin()[i] -= c * d.rbegin()[i];
@@ -138,7 +195,7 @@ struct FormalPowerSeries : public std::vector<T> {
     } else {
       auto q = *this / d;
       F q0(q.begin(), q.begin() + std::min(q.size(), d.size()));
-      auto r = *this - d * q0;
+      F r = *this - d * q0;
       r.resize(d.size() - 1);
       return std::pair<F, F>(std::move(q), std::move(r));
     }
@@ -176,45 +233,102 @@ int val(const FormalPowerSeries<T>& P) {
   return iter - P.begin();
 }
 
+namespace product_auxiliary {
+
+constexpr int block_size = 64;
+constexpr int parallel_threshold = 1 << 14;
+
+// Huffman tree over the factors, always merging the two smallest partial products.
+// Leaves are 0, ..., N - 1 and the internal node N + i has children child[i].
 template <typename T>
-FormalPowerSeries<T> product(const FormalPowerSeries<T>* p, int N) {
-  if (N == 0) {
-    return {1};
-  } else if (N == 1) {
-    return *p;
-  } else {
-    int h = N / 2;
-    return product(p, h) * product(p + h, N - h);
+struct ProductTree {
+  using F = FormalPowerSeries<T>;
+
+  const F* p;
+  int N;
+  std::vector<long long> size;
+  std::vector<std::array<int, 2>> child;
+
+  ProductTree(const F* p, int N) : p(p), N(N), size(N) {
+    using Item = std::pair<long long, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+    for (int i = 0; i < N; ++i) {
+      size[i] = p[i].size();
+      pq.emplace(size[i], i);
+    }
+    while (pq.size() > 1) {
+      auto [s, u] = pq.top();
+      pq.pop();
+      auto [t, v] = pq.top();
+      pq.pop();
+      child.push_back({u, v});
+      size.push_back(s + t - 1);
+      pq.emplace(size.back(), size.size() - 1);
+    }
   }
-}
 
+  // Runs one of the children on a new thread while both are large and there are threads left.
+  F merge(int u, int threads) const {
+    if (u < N) {
+      return p[u];
+    }
+    auto [l, r] = child[u - N];
+    if (threads > 1 && std::min(size[l], size[r]) >= parallel_threshold) {
+      auto future = std::async(std::launch::async, &ProductTree::merge, this, l, threads / 2);
+      auto R = merge(r, threads - threads / 2);
+      return future.get() * std::move(R);
+    }
+    return merge(l, threads) * merge(r, threads);
+  }
+};
+
+// Multiplies consecutive linear factors c0 + c1 x in blocks of block_size, in place.
+template <typename T, typename Function>
+std::vector<FormalPowerSeries<T>> linear_blocks(int N, Function factor) {
+  std::vector<FormalPowerSeries<T>> blocks;
+  for (int s = 0; s < N; s += block_size) {
+    int len = std::min(block_size, N - s);
+    FormalPowerSeries<T> q(len + 1);
+    q[0] = 1;
+    for (int i = 0; i < len; ++i) {
+      auto [c0, c1] = factor(s + i);
+      for (int j = i + 1; j > 0; --j) {
+        q[j] = c0 * q[j] + c1 * q[j - 1];
+      }
+      q[0] *= c0;
+    }
+    blocks.push_back(std::move(q));
+  }
+  return blocks;
+}
 
-#include <iostream>
+}  // namespace product_auxiliary
 
+// Returns the product of p[0], ..., p[N - 1], merging by size and in parallel.
+// Time complexity: O(convolution(S) * log(N)), where S is the total size.
 template <typename T>
-FormalPowerSeries<T> inv(const FormalPowerSeries<T>& A) {
-  int N = A.size();
-  if (N == 1) {
-    return {1 / A[0]};
-  }
-  auto Aneg = A;
-  for (int i = 1; i < N; i += 2) {
-    Aneg[i] = -A[i];
-  }
-  auto B = A * Aneg;
-  int K = (N + 1) / 2;
-  FormalPowerSeries<T> C(K);
-  for (int i = 0; i < K; ++i) {
-    C[i] = B[2 * i];
+FormalPowerSeries<T> product(const FormalPowerSeries<T>* p, int N,
+                             int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  namespace aux = product_auxiliary;
+  if (N == 0) {
+    return {1};
   }
-  auto invC = inv(C);
-  FormalPowerSeries<T> invB(N);
-  for (int i = 0; i < K; ++i) {
-    invB[2 * i] = invC[i];
+  if (std::all_of(p, p + N, [](const auto& f) { return f.size() == 2; })) {
+    auto blocks = aux::linear_blocks<T>(N, [&](int i) { return std::pair<T, T>(p[i][0], p[i][1]); });
+    if (blocks.size() > 1) {
+      return aux::ProductTree<T>(blocks.data(), blocks.size()).merge(2 * blocks.size() - 2, threads);
+    }
+    return blocks[0];
   }
-  auto res = Aneg * invB;
-  res.resize(N);
-  return res;
+  return aux::ProductTree<T>(p, N).merge(2 * N - 2, threads);
+}
+
+// Returns the product of (1 - a[i] x).
+template <typename T>
+FormalPowerSeries<T> product_of_linear_factors(const std::vector<T>& a,
+                                               int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  auto blocks = product_auxiliary::linear_blocks<T>(a.size(), [&](int i) { return std::pair<T, T>(1, -a[i]); });
+  return product(blocks.data(), blocks.size(), threads);
 }
 
 template <typename T>
@@ -240,11 +354,135 @@ FormalPowerSeries<T> I(FormalPowerSeries<T> P) {
   return P;
 }
 
+namespace sparse {
+
+// Nonzero coefficients as (index, value) pairs.
+template <typename T>
+std::vector<std::pair<int, T>> non_zero(const FormalPowerSeries<T>& P) {
+  std::vector<std::pair<int, T>> I;
+  for (int i = 0; i < P.size(); ++i) {
+    if (P[i] != 0) {
+      I.emplace_back(i, P[i]);
+    }
+  }
+  return I;
+}
+
+// Time complexity of the operations below: O(N * non_zero(P).size()).
+
+template <typename T>
+FormalPowerSeries<T> inv(const FormalPowerSeries<T>& P) {
+  assert(!P.empty() && P[0] != 0);
+  int N = P.size();
+  auto nz = non_zero(P);
+  nz.erase(nz.begin());
+  FormalPowerSeries<T> Q(N);
+  Q[0] = 1 / P[0];
+  for (int j = 1; j < N; ++j) {
+    for (auto [i, c] : nz) {
+      if (i > j) break;
+      Q[j] -= c * Q[j - i];
+    }
+    Q[j] *= Q[0];
+  }
+  return Q;
+}
+
+template <typename T>
+FormalPowerSeries<T> exp(const FormalPowerSeries<T>& P) {
+  assert(!P.empty() && P[0] == 0);
+  int N = P.size();
+  auto nz = non_zero(D(P));
+  FormalPowerSeries<T> Q(N);
+  Q[0] = 1;
+  for (int i = 0; i + 1 < N; ++i) {
+    T dQ = 0;
+    for (auto [j, c] : nz) {
+      if (j > i) break;
+      dQ += Q[i - j] * c;
+    }
+    Q[i + 1] = Combinatorics<T>::r(i + 1) * dQ;
+  }
+  return Q;
+}
+
 template <typename T>
 FormalPowerSeries<T> log(const FormalPowerSeries<T>& P) {
   assert(!P.empty() && P[0] == 1);
   int N = P.size();
-  auto r = D(P) * inv(P);
+  auto nz = non_zero(P);
+  nz.erase(nz.begin());
+  FormalPowerSeries<T> dQ(N - 1);
+  for (int i = 0; i < N - 1; ++i) {
+    dQ[i] = (i + 1) * P[i + 1];
+    for (auto [j, c] : nz) {
+      if (j > i) break;
+      dQ[i] -= dQ[i - j] * c;
+    }
+  }
+  return I(std::move(dQ));
+}
+
+template <typename T>
+FormalPowerSeries<T> pow(const FormalPowerSeries<T>& P, T alpha) {
+  assert(!P.empty() && P[0] == 1);
+  int N = P.size();
+  auto nz = non_zero(P);
+  nz.erase(nz.begin());
+  FormalPowerSeries<T> Q(N), dQ(N - 1);
+  Q[0] = 1;
+  for (int i = 0; i + 1 < N; ++i) {
+    for (auto [j, c] : nz) {
+      if (j - 1 > i) break;
+      dQ[i] += j * c * Q[i - j + 1];
+    }
+    dQ[i] *= alpha;
+    for (auto [j, c] : nz) {
+      if (j > i) break;
+      dQ[i] -= c * dQ[i - j];
+    }
+    Q[i + 1] = dQ[i] * Combinatorics<T>::r(i + 1);
+  }
+  return Q;
+}
+
+}  // namespace sparse
+
+namespace dense {
+
+// Newton iterations.
+
+template <typename T>
+FormalPowerSeries<T> inv(const FormalPowerSeries<T>& A) {
+  int N = A.size();
+  if (N == 1) {
+    return {1 / A[0]};
+  }
+  auto Aneg = A;
+  for (int i = 1; i < N; i += 2) {
+    Aneg[i] = -A[i];
+  }
+  auto B = A * Aneg;
+  int K = (N + 1) / 2;
+  FormalPowerSeries<T> C(K);
+  for (int i = 0; i < K; ++i) {
+    C[i] = B[2 * i];
+  }
+  auto invC = dense::inv(C);
+  FormalPowerSeries<T> invB(N);
+  for (int i = 0; i < K; ++i) {
+    invB[2 * i] = invC[i];
+  }
+  auto res = Aneg * invB;
+  res.resize(N);
+  return res;
+}
+
+template <typename T>
+FormalPowerSeries<T> log(const FormalPowerSeries<T>& P) {
+  assert(!P.empty() && P[0] == 1);
+  int N = P.size();
+  auto r = D(P) * dense::inv(P);
   r.resize(N - 1);
   return I(std::move(r));
 }
@@ -257,7 +495,7 @@ FormalPowerSeries<T> exp(const FormalPowerSeries<T>& P) {
   while (K < N) {
     K *= 2;
     Q.resize(K);
-    auto B = -log(Q);
+    auto B = -dense::log(Q);
     B[0] += 1;
     for (int i = 0; i < std::min(N, K); ++i) {
       B[i] += P[i];
@@ -272,7 +510,54 @@ FormalPowerSeries<T> exp(const FormalPowerSeries<T>& P) {
 template <typename T>
 FormalPowerSeries<T> pow(const FormalPowerSeries<T>& P, T alpha) {
   assert(!P.empty() && P[0] == 1);
-  return exp(alpha * log(P));
+  return dense::exp<T>(alpha * dense::log(P));
+}
+
+}  // namespace dense
+
+namespace sparse_dense_auxiliary {
+
+// The recurrences in sparse:: cost O(N * K) for K nonzero coefficients and the Newton iterations O(N * log(N)), so the
+// sparse ones win while K <= c * log2(N). The constants are the crossovers measured with the NTT convolution for
+// N from 2^12 to 2^20; slower convolutions only move them up.
+constexpr double inv_cost = 20, log_cost = 28, exp_cost = 40, pow_cost = 22;
+
+template <typename T>
+bool use_sparse(const FormalPowerSeries<T>& P, double c) {
+  int N = P.size();
+  if (N == 0) return false;
+  double limit = c * std::log2(N + 1);
+  int K = 0;
+  for (int i = 0; i < N && K <= limit; ++i) {
+    K += P[i] != 0;
+  }
+  return K <= limit;
+}
+
+}  // namespace sparse_dense_auxiliary
+
+template <typename T>
+FormalPowerSeries<T> inv(const FormalPowerSeries<T>& P) {
+  namespace aux = sparse_dense_auxiliary;
+  return aux::use_sparse(P, aux::inv_cost) ? sparse::inv(P) : dense::inv(P);
+}
+
+template <typename T>
+FormalPowerSeries<T> log(const FormalPowerSeries<T>& P) {
+  namespace aux = sparse_dense_auxiliary;
+  return aux::use_sparse(P, aux::log_cost) ? sparse::log(P) : dense::log(P);
+}
+
+template <typename T>
+FormalPowerSeries<T> exp(const FormalPowerSeries<T>& P) {
+  namespace aux = sparse_dense_auxiliary;
+  return aux::use_sparse(P, aux::exp_cost) ? sparse::exp(P) : dense::exp(P);
+}
+
+template <typename T>
+FormalPowerSeries<T> pow(const FormalPowerSeries<T>& P, T alpha) {
+  namespace aux = sparse_dense_auxiliary;
+  return aux::use_sparse(P, aux::pow_cost) ? sparse::pow(P, alpha) : dense::pow(P, alpha);
 }
 
 // Returns composition f(g(x)) modulo x^M.
@@ -306,208 +591,154 @@ FormalPowerSeries<T> composition(const FormalPowerSeries<T>& f, const FormalPowe
   return res;
 }
 
-namespace sparse {
-
+// Subproduct tree stored level by level in a single buffer: level k holds the products over the blocks of 2^k
+// consecutive points, the j-th one taking 2^k + 1 coefficients starting at offset[k] + j * (2^k + 1).
+// All the traversals are iterative and work in place on the buffers below, which are reused across calls.
 template <typename T>
-std::vector<int> non_zero(const FormalPowerSeries<T>& P) {
-  std::vector<int> I;
-  for (int i = 0; i < P.size(); ++i) {
-    if (P[i] != 0) {
-      I.push_back(i);
-    }
-  }
-  return I;
-}
+struct Interpolator {
+  using F = FormalPowerSeries<T>;
+  static constexpr int naive_threshold = 64;
 
-// Time complexity of the operations below: O(N * non_zero(P).size()).
+  int N, H;
+  std::vector<T> tree;
+  std::vector<int> offset;
+  std::vector<T> weights;  // weights[i] = 1 / P'(x[i]), where P is the product at the root.
+  std::vector<T> buffer, temp;
 
-template <typename T>
-FormalPowerSeries<T> inv(const FormalPowerSeries<T>& P) {
-  assert(!P.empty() && P[0] != 0);
-  int N = P.size();
-  auto I = non_zero(P);
-  I.erase(I.begin());
-  FormalPowerSeries<T> Q(N);
-  Q[0] = 1 / P[0];
-  for (int j = 1; j < N; ++j) {
-    for (auto i : I) {
-      if (i > j) break;
-      Q[j] -= P[i] * Q[j - i];
+  // Range [first, last) should be the domain points.
+  template <typename Iterator>
+  Interpolator(Iterator first, Iterator last) : N(last - first), H(0), buffer(N) {
+    assert(N > 0);
+    while ((1 << H) < N) ++H;
+    offset.assign(H + 2, 0);
+    for (int k = 0; k <= H; ++k) {
+      offset[k + 1] = offset[k] + blocks(k) * ((1 << k) + 1);
     }
-    Q[j] *= Q[0];
-  }
-  return Q;
-}
-
-
-template <typename T>
-FormalPowerSeries<T> exp(const FormalPowerSeries<T>& P) {
-  assert(!P.empty() && P[0] == 0);
-  int N = P.size();
-  auto dP = D(P);
-  auto I = non_zero(dP);
-  FormalPowerSeries<T> dQ(N - 1), Q(N);
-  Q[0] = 1;
-  for (int i = 0; i + 1 < N; ++i) {
-    for (auto j : I) {
-      if (j > i) break;
-      dQ[i] += Q[i - j] * dP[j];
+    tree.resize(offset[H + 1]);
+    for (int i = 0; i < N; ++i) {
+      tree[2 * i] = -first[i];
+      tree[2 * i + 1] = 1;
     }
-    Q[i + 1] = Combinatorics<T>::r(i + 1) * dQ[i];
-  }
-  return Q;
-}
-
-template <typename T>
-FormalPowerSeries<T> log(const FormalPowerSeries<T>& P) {
-  assert(!P.empty() && P[0] == 1);
-  int N = P.size();
-  auto dP = D(P);
-  auto J = non_zero(P);
-  J.erase(J.begin());
-  FormalPowerSeries<T> dQ(N - 1);
-  for (int i = 0; i < N - 1; ++i) {
-    dQ[i] += dP[i];
-    for (auto j : J) {
-      if (j > i) break;
-      dQ[i] -= dQ[i - j] * P[j];
+    for (int k = 0; k < H; ++k) {
+      for (int j = 0; 2 * j < blocks(k); ++j) {
+        int l = length(k, 2 * j);
+        if (2 * j + 1 == blocks(k)) {
+          std::copy_n(node(k, 2 * j), l + 1, node(k + 1, j));
+        } else {
+          int r = length(k, 2 * j + 1);
+          std::fill_n(node(k + 1, j), l + r + 1, T(0));
+          multiply_add(node(k, 2 * j), l + 1, node(k, 2 * j + 1), r + 1, node(k + 1, j));
+        }
+      }
     }
   }
-  return I(dQ);
-}
 
-template <typename T>
-FormalPowerSeries<T> pow(const FormalPowerSeries<T>& P, T alpha) {
-  assert(!P.empty() && P[0] == 1);
-  int N = P.size();
-  auto I = non_zero(P);
-  I.erase(I.begin());
-  auto dP = D(P);
-  FormalPowerSeries<T> Q(N), dQ(N - 1);
-  Q[0] = 1;
-  for (int i = 0; i + 1 < N; ++i) {
-    for (auto j : I) {
-      --j;
-      if (j > i) break;
-      dQ[i] += dP[j] * Q[i - j];
-    }
-    dQ[i] *= alpha;
-    for (auto j : I) {
-      if (j > i) break;
-      dQ[i] -= P[j] * dQ[i - j];
-    }
-    Q[i + 1] = dQ[i] * Combinatorics<T>::r(i + 1);
+  int blocks(int k) const {
+    return ((N - 1) >> k) + 1;
   }
-  return Q;
-}
 
-}
+  // Number of points below the j-th node of level k.
+  int length(int k, int j) const {
+    return std::min(1 << k, N - (j << k));
+  }
 
-template <typename T>
-struct Interpolator {
-  using F = FormalPowerSeries<T>;
-  struct Node {
-    F P;
-    T y;
-    Node* left = nullptr;
-    Node* right = nullptr;
-  };
-  std::deque<Node> deq;
+  T* node(int k, int j) {
+    return tree.data() + offset[k] + j * ((1 << k) + 1);
+  }
 
-  // Range [first, last) should be the domain points.
-  template <typename Iterator>
-  Interpolator(Iterator first, Iterator last) {
-    deq.emplace_back();
-    Node* root = &deq.back();
-    build(root, first, last);
+  F polynomial(int k, int j) {
+    return F(node(k, j), node(k, j) + length(k, j) + 1);
   }
 
-  template <typename Iterator>
-  void build(Node* node, Iterator first, Iterator last) {
-    int len = last - first;
-    if (len == 1) {
-      node->P = {-first[0], T(1)};
+  // out[0, n + m - 1) += a[0, n) * b[0, m).
+  void multiply_add(const T* a, int n, const T* b, int m, T* out) {
+    if (std::min(n, m) <= naive_threshold) {
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+          out[i + j] += a[i] * b[j];
+        }
+      }
     } else {
-      deq.emplace_back();
-      node->left = &deq.back();
-      deq.emplace_back();
-      node->right = &deq.back();
-      Iterator middle = first + len / 2;
-      build(node->left, first, middle);
-      build(node->right, middle, last);
-      node->P = node->left->P * node->right->P;
+      auto c = F(a, a + n) * F(b, b + m);
+      for (int i = 0; i < n + m - 1; ++i) {
+        out[i] += c[i];
+      }
     }
   }
 
-  std::vector<T> res;
+  // Divides a[0, n) by the monic polynomial d of degree m < n, leaving the remainder in a[0, m) and the quotient in
+  // a[m, n).
+  void divide(T* a, int n, const T* d, int m) {
+    if (m <= naive_threshold) {
+      for (int i = n - 1; i >= m; --i) {
+        for (int t = 0; t < m; ++t) {
+          a[i - m + t] -= a[i] * d[t];
+        }
+      }
+    } else {
+      auto [q, r] = F(a, a + n).euclidean_division(F(d, d + m + 1));
+      std::copy_n(r.begin(), m, a);
+      std::copy_n(q.begin(), n - m, a + m);
+    }
+  }
 
   // Evaluates Q in the domain points.
   std::vector<T> evaluate(const F& Q) {
-    res.clear();
-    evaluate_aux(&deq[0], Q % deq[0].P);
-    return std::move(res);
-  }
-
-  void evaluate_aux(Node* node, const F& Q) {
-    if (node->left) {
-      for (auto next : {node->left, node->right}) {
-        evaluate_aux(next, Q % next->P);
-      }
+    std::fill(buffer.begin(), buffer.end(), T(0));
+    if (Q.size() > N) {
+      auto R = Q % polynomial(H, 0);
+      std::copy(R.begin(), R.end(), buffer.begin());
     } else {
-      assert(Q.size() == 1);
-      res.push_back(Q[0]);
+      std::copy(Q.begin(), Q.end(), buffer.begin());
+    }
+    for (int k = H; k > 0; --k) {
+      for (int j = 0; 2 * j + 1 < blocks(k - 1); ++j) {
+        int l = length(k - 1, 2 * j), r = length(k - 1, 2 * j + 1);
+        T* v = buffer.data() + (j << k);
+        temp.assign(v, v + l + r);
+        divide(temp.data(), l + r, node(k - 1, 2 * j + 1), r);
+        divide(v, l + r, node(k - 1, 2 * j), l);
+        std::copy_n(temp.begin(), r, v + l);
+      }
     }
+    return buffer;
   }
 
-  bool initiliazed = false;
-
   // Range [first, last) should be the image.
   // Returns the unique polynomial P with evaluate(P) = [first, last).
   template <typename Iterator>
   F interpolate(Iterator first, Iterator last) {
-    if (!initiliazed) {
-      auto y = evaluate(D(deq[0].P));
-      auto iter = y.begin();
-      for (auto& node : deq) {
-        if (node.left) continue;
-        node.y = *iter;
-        ++iter;
-      }
-      initiliazed = true;
+    assert(last - first == N);
+    if (weights.empty()) {
+      weights = evaluate(D(polynomial(H, 0)));
+      batch_inverse(weights.begin(), weights.end());
     }
-    return interpolate_aux(&deq[0], first, last);
-  }
-
-  template <typename Iterator>
-  F interpolate_aux(Node* node, Iterator first, Iterator last) {
-    int len = last - first;
-    if (len == 1) {
-      return {first[0] / node->y};
-    } else {
-      Iterator middle = first + len / 2;
-      return node->right->P * interpolate_aux(node->left, first, middle) +
-        node->left->P * interpolate_aux(node->right, middle, last);
+    for (int i = 0; i < N; ++i) {
+      buffer[i] = first[i] * weights[i];
+    }
+    for (int k = 1; k <= H; ++k) {
+      for (int j = 0; 2 * j + 1 < blocks(k - 1); ++j) {
+        int l = length(k - 1, 2 * j), r = length(k - 1, 2 * j + 1);
+        T* v = buffer.data() + (j << k);
+        temp.assign(l + r, T(0));
+        multiply_add(v, l, node(k - 1, 2 * j + 1), r + 1, temp.data());
+        multiply_add(v + l, r, node(k - 1, 2 * j), l + 1, temp.data());
+        std::copy(temp.begin(), temp.end(), v);
+      }
     }
+    return F(buffer.begin(), buffer.end());
   }
 
   // Assumes the size of P is the same as the number of points.
   F to_newton_basis(F P) {
-    return to_newton_basis_aux(&deq[0], P);
-  }
-
-  F to_newton_basis_aux(Node* node, const F& P) {
-    if (node->left) {
-      auto [Q, R] = P.euclidean_division(node->left->P);
-      F A = to_newton_basis_aux(node->left, R);
-      F B = to_newton_basis_aux(node->right, Q);
-      B.insert(B.begin(), A.size(), 0);
-      return A + B;
-      return {};
-    } else {
-      assert(P.size() == 1);
-      return {P[0]};
-      return {};
+    assert(P.size() == N);
+    for (int k = H; k > 0; --k) {
+      for (int j = 0; 2 * j + 1 < blocks(k - 1); ++j) {
+        int l = length(k - 1, 2 * j), r = length(k - 1, 2 * j + 1);
+        divide(P.data() + (j << k), l + r, node(k - 1, 2 * j), l);
+      }
     }
+    return P;
   }
 };
 
@@ -527,31 +758,114 @@ std::vector<T> chirp_z_transform(FormalPowerSeries<T> p, T a, T r, int M) {
   }
 
   int N = p.size();
-
-  FormalPowerSeries<T> A(N);
-  for (int i = 0; i < N; ++i) {
-    int idx = N - 1 - i;
-    long long e = 1LL * i * (i - 1) / 2;
-    A[idx] = p[i] * pow(a, i) / pow(r, e);
+  if (N == 0) {
+    return std::vector<T>(M);
   }
 
-  FormalPowerSeries<T> B(N + M);
+  // The chirp factors r^(i(i - 1)/2) and their inverses follow from running products, since consecutive exponents
+  // differ by i.
+  T rinv = 1 / r;
+  FormalPowerSeries<T> A(N), B(N + M);
+  T chirp = 1, step = 1, ichirp = 1, istep = 1, apow = 1;
   for (int i = 0; i < N + M; ++i) {
-    long long e = 1LL * i * (i - 1) / 2;
-    B[i] = pow(r, e);
+    B[i] = chirp;
+    if (i < N) {
+      A[N - 1 - i] = p[i] * apow * ichirp;
+      apow *= a;
+    }
+    chirp *= step, step *= r;
+    ichirp *= istep, istep *= rinv;
   }
 
   auto C = A * B;
 
   std::vector<T> y(M);
+  ichirp = 1, istep = 1;
   for (int i = 0; i < M; ++i) {
-    long long e = 1LL * i * (i - 1) / 2;
-    y[i] = C[i + N - 1] / pow(r, e);
+    y[i] = C[i + N - 1] * ichirp;
+    ichirp *= istep, istep *= rinv;
   }
 
   return y;
 }
 
+// Returns a vector y of size M with y[i] = p(a r^i).
+template <typename T>
+std::vector<T> evaluate_geometric(FormalPowerSeries<T> p, T a, T r, int M) {
+  return chirp_z_transform(std::move(p), a, r, M);
+}
+
+// Returns the unique polynomial p of degree < N with p(a r^i) = y[i], assuming a != 0 and distinct points.
+// For a = 1, Lagrange's formula reads p(x) = m(x) * sum c[i] / (x - r^i), where m is the product of the x - r^i and
+// c[i] = y[i] / m'(r^i). The power series of the sum has coefficients -C(r^(-k - 1)), where C has coefficients c,
+// so it is a single chirp z-transform, and both m and the weights m'(r^i) have closed forms.
+// Time complexity: O(convolution(N)).
+template <typename T>
+FormalPowerSeries<T> interpolate_geometric(const std::vector<T>& y, T a, T r) {
+  using F = FormalPowerSeries<T>;
+  int N = y.size();
+  if (N == 0) {
+    return {};
+  }
+  auto power = [](T x, long long e) {
+    T res = 1;
+    for (; e; e >>= 1, x *= x) {
+      if (e & 1) res *= x;
+    }
+    return res;
+  };
+  T rinv = 1 / r;
+
+  // With s[k] = (r - 1)(r^2 - 1)...(r^k - 1), m'(r^i) = (-1)^(N - 1 - i) r^e[i] s[i] s[N - 1 - i], where
+  // e[i] = i(i - 1)/2 + i(N - 1 - i) and e[i + 1] - e[i] = N - 2 - i.
+  std::vector<T> s(N), w(N);
+  s[0] = 1;
+  T rk = 1;
+  for (int k = 1; k < N; ++k) {
+    rk *= r;
+    s[k] = s[k - 1] * (rk - 1);
+  }
+  T chirp = 1, step = rk * rinv;
+  for (int i = 0; i < N; ++i) {
+    w[i] = chirp * s[i] * s[N - 1 - i];
+    if ((N - 1 - i) % 2) w[i] = -w[i];
+    chirp *= step, step *= rinv;
+  }
+
+  batch_inverse(w.begin(), w.end());
+  F c(N);
+  for (int i = 0; i < N; ++i) {
+    c[i] = y[i] * w[i];
+  }
+
+  auto S = chirp_z_transform(std::move(c), rinv, rinv, N);
+
+  // m is built by doubling: the product over r^m, ..., r^(2m - 1) is r^(m^2) m(x / r^m).
+  F m = {1};
+  for (int b = 31 - __builtin_clz(N); b >= 0; --b) {
+    int h = m.size() - 1;
+    F shifted(m);
+    T scale = power(rinv, h), x = power(r, 1LL * h * h);
+    for (auto& coef : shifted) {
+      coef *= x;
+      x *= scale;
+    }
+    m *= shifted;
+    if (N >> b & 1) {
+      m *= F{-power(r, 2 * h), 1};
+    }
+  }
+
+  F P(S.begin(), S.end());
+  P *= m;
+  P.resize(N);
+  T ainv = 1 / a, x = -1;
+  for (auto& coef : P) {
+    coef *= x;
+    x *= ainv;
+  }
+  return P;
+}
 
 namespace scaled {
 
@@ -573,16 +887,18 @@ FormalPowerSeries<T> exp(T alpha, int N) {
 // Maps x^k -> x^k / k!.
 template <typename T>
 FormalPowerSeries<T> borel(FormalPowerSeries<T> P) {
-  const auto& combi = Combinatorics<T>::get_instance();
-  std::transform(P.begin(), P.end(), std::begin(combi.rfact), P.begin(), std::multiplies<T>());
+  for (int k = 0; k < P.size(); ++k) {
+    P[k] *= Combinatorics<T>::rf(k);
+  }
   return P;
 }
 
 // Maps x^k -> k! * x^k.
 template <typename T>
 FormalPowerSeries<T> laplace(FormalPowerSeries<T> P) {
-  const auto& combi = Combinatorics<T>::get_instance();
-  std::transform(P.begin(), P.end(), std::begin(combi.fact), P.begin(), std::multiplies<T>());
+  for (int k = 0; k < P.size(); ++k) {
+    P[k] *= Combinatorics<T>::f(k);
+  }
   return P;
 }
 
@@ -6,8 +6,10 @@
 #include "algorithms/mathematics/fft"
 #include "algorithms/mathematics/formal_power_series"
 
+namespace dense {
+
 template <>
-FormalPowerSeries<Z<ntt_mod>> inv(const FormalPowerSeries<Z<ntt_mod>>& P) {
+inline FormalPowerSeries<Z<ntt_mod>> inv(const FormalPowerSeries<Z<ntt_mod>>& P) {
   using F = FormalPowerSeries<Z<ntt_mod>>;
   using T = Z<ntt_mod>;
   assert(!P.empty() && P[0] != 0);
@@ -30,5 +32,7 @@ FormalPowerSeries<Z<ntt_mod>> inv(const FormalPowerSeries<Z<ntt_mod>>& P) {
   return F(Q);
 }
 
+}  // namespace dense
+
 
 #endif  // ALGORITHMS_MATHEMATICS_FORMAL_POWER_SERIES_ZP_HPP
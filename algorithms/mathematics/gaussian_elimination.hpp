@@ -4,101 +4,250 @@
 #include "algorithms/mathematics/matrix"
 
 #include <algorithm>
+#include <cassert>
 #include <utility>
 #include <vector>
 
+// Factorization PA = LU in row echelon form. The t-th pivot is at (t, columns[t]); the multipliers of L for it are
+// stored below it in LU, and U fills the rest of the first rank rows. Row t of LU is row perm[t] of A.
 template <typename T>
 struct GaussianElimination {
+  static constexpr int block_size = 64;
+
   int N, M;
-  Matrix<T> A, E;
-  std::vector<int> pivot;
+  DenseMatrix<T> LU;
+  std::vector<int> perm, columns, pivot;
+  std::vector<T> inv_pivot;
   int rank, nullity;
 
+  // Columns are factored in panels of block_size. A panel is eliminated on its own columns only, and the rest of its
+  // rows and the trailing submatrix are then updated at once, the latter as a single product.
   // Time complexity: O(std::min(N, M)NM).
-  GaussianElimination(const Matrix<T>& A_) : A(A_) {
-    N = A.size(), M = A[0].size();
-    E = Matrix<T>(N, std::vector<T>(N));
+  GaussianElimination(DenseMatrix<T> A) : N(A.N), M(A.M), LU(std::move(A)), perm(N), pivot(M, -1) {
     for (int i = 0; i < N; ++i) {
-      E[i][i] = 1;
+      perm[i] = i;
     }
-    rank = 0, nullity = M;
-    pivot.assign(M, -1);
-    for (int col = 0, row = 0; col < M && row < N; ++col) {
-      int sel = -1;
-      for (int i = row; i < N; ++i) {
-        if (A[i][col] != 0) {
-          sel = i;
-          break;
+    int row = 0;
+    for (int c0 = 0; c0 < M && row < N; c0 += block_size) {
+      int c1 = std::min(M, c0 + block_size), r0 = row;
+      for (int col = c0; col < c1 && row < N; ++col) {
+        int sel = -1;
+        for (int i = row; i < N; ++i) {
+          if (LU[i][col] != 0) {
+            sel = i;
+            break;
+          }
+        }
+        if (sel == -1) continue;
+        if (sel != row) {
+          std::swap_ranges(LU[sel], LU[sel] + M, LU[row]);
+          std::swap(perm[sel], perm[row]);
+        }
+        T inv = 1 / LU[row][col];
+        for (int i = row + 1; i < N; ++i) {
+          T c = LU[i][col] *= inv;
+          if (c == 0) continue;
+          for (int j = col + 1; j < c1; ++j) {
+            LU[i][j] -= c * LU[row][j];
+          }
         }
+        inv_pivot.push_back(inv);
+        columns.push_back(col);
+        pivot[col] = row++;
       }
-      if (sel == -1) continue;
-      if (sel != row) {
-        std::swap(A[sel], A[row]);
-        std::swap(E[sel], E[row]);
+      int p = row - r0;
+      if (p == 0 || c1 == M) continue;
+      for (int t = 0; t < p; ++t) {
+        for (int s = t + 1; s < p; ++s) {
+          T c = LU[r0 + s][columns[r0 + t]];
+          if (c == 0) continue;
+          for (int j = c1; j < M; ++j) {
+            LU[r0 + s][j] -= c * LU[r0 + t][j];
+          }
+        }
       }
-      for (int i = 0; i < N; ++i) {
-        if (i == row) continue;
-        T c = A[i][col] / A[row][col];
-        for (int j = col; j < M; ++j) {
-          A[i][j] -= c * A[row][j];
+      if (row == N) continue;
+      DenseMatrix<T> L(N - row, p), U(p, M - c1);
+      for (int i = row; i < N; ++i) {
+        for (int t = 0; t < p; ++t) {
+          L[i - row][t] = LU[i][columns[r0 + t]];
         }
-        for (int j = 0; j < N; ++j) {
-          E[i][j] -= c * E[row][j];
+      }
+      for (int t = 0; t < p; ++t) {
+        std::copy(LU[r0 + t] + c1, LU[r0 + t] + M, U[t]);
+      }
+      auto S = L * U;
+      for (int i = row; i < N; ++i) {
+        for (int j = c1; j < M; ++j) {
+          LU[i][j] -= S[i - row][j - c1];
         }
       }
-      pivot[col] = row++;
-      ++rank, --nullity;
     }
+    rank = row, nullity = M - rank;
   }
 
-  // Time complexity: O(N^2 + M).
-  std::pair<bool, std::vector<T>> solve(std::vector<T> b, bool reduced = false) const {
+  GaussianElimination(const Matrix<T>& A) : GaussianElimination(DenseMatrix<T>(A)) {}
+
+  // Time complexity: O(NM).
+  std::pair<bool, std::vector<T>> solve(const std::vector<T>& b) const {
     assert(N == b.size());
-    if (!reduced) {
-      b = E * b;
+    std::vector<T> y(N), x(M);
+    for (int i = 0; i < N; ++i) {
+      y[i] = b[perm[i]];
+      for (int t = 0; t < std::min(i, rank); ++t) {
+        y[i] -= LU[i][columns[t]] * y[t];
+      }
     }
-    std::vector<T> x(M);
-    for (int j = 0; j < M; ++j) {
-      if (pivot[j] == -1) continue;
-      x[j] = b[pivot[j]] / A[pivot[j]][j];
-      b[pivot[j]] = 0;
+    back_substitute(y, x);
+    for (int i = rank; i < N; ++i) {
+      if (y[i] != 0) return std::pair(false, x);
     }
+    return std::pair(true, x);
+  }
+
+  // Solves AX = B for every column of B at once, returning whether all of them are solvable and a solution with the
+  // free variables 0. Both substitutions go by panels of block_size pivots: a panel is solved on its own rows, and the
+  // rows it affects are then updated by a single product.
+  // Time complexity: O(NMK) for K columns, mostly in matrix products.
+  std::pair<bool, DenseMatrix<T>> solve(const DenseMatrix<T>& B) const {
+    assert(N == B.N);
+    int K = B.M;
+    DenseMatrix<T> Y(N, K), Z(rank, K), X(M, K);
     for (int i = 0; i < N; ++i) {
-      if (b[i] != 0) return std::pair(false, x);
+      std::copy(B[perm[i]], B[perm[i]] + K, Y[i]);
     }
-    return std::pair(true, x);
+    for (int t0 = 0; t0 < rank; t0 += block_size) {
+      int t1 = std::min(rank, t0 + block_size);
+      for (int s = t0; s < t1; ++s) {
+        for (int t = t0; t < s; ++t) {
+          T c = LU[s][columns[t]];
+          if (c == 0) continue;
+          for (int j = 0; j < K; ++j) {
+            Y[s][j] -= c * Y[t][j];
+          }
+        }
+      }
+      if (t1 == N) continue;
+      DenseMatrix<T> L(N - t1, t1 - t0), V(t1 - t0, K);
+      for (int i = t1; i < N; ++i) {
+        for (int t = t0; t < t1; ++t) {
+          L[i - t1][t - t0] = LU[i][columns[t]];
+        }
+      }
+      for (int t = t0; t < t1; ++t) {
+        std::copy(Y[t], Y[t] + K, V[t - t0]);
+      }
+      auto S = L * V;
+      for (int i = t1; i < N; ++i) {
+        for (int j = 0; j < K; ++j) {
+          Y[i][j] -= S[i - t1][j];
+        }
+      }
+    }
+    // Z[t] is the row of X at columns[t].
+    for (int t1 = rank; t1 > 0; t1 -= block_size) {
+      int t0 = std::max(0, t1 - block_size);
+      if (t1 < rank) {
+        DenseMatrix<T> U(t1 - t0, rank - t1), W(rank - t1, K);
+        for (int t = t0; t < t1; ++t) {
+          for (int s = t1; s < rank; ++s) {
+            U[t - t0][s - t1] = LU[t][columns[s]];
+          }
+        }
+        for (int s = t1; s < rank; ++s) {
+          std::copy(Z[s], Z[s] + K, W[s - t1]);
+        }
+        auto S = U * W;
+        for (int t = t0; t < t1; ++t) {
+          for (int j = 0; j < K; ++j) {
+            Y[t][j] -= S[t - t0][j];
+          }
+        }
+      }
+      for (int t = t1 - 1; t >= t0; --t) {
+        for (int s = t + 1; s < t1; ++s) {
+          T c = LU[t][columns[s]];
+          if (c == 0) continue;
+          for (int j = 0; j < K; ++j) {
+            Y[t][j] -= c * Z[s][j];
+          }
+        }
+        for (int j = 0; j < K; ++j) {
+          Z[t][j] = Y[t][j] * inv_pivot[t];
+        }
+      }
+    }
+    for (int t = 0; t < rank; ++t) {
+      std::copy(Z[t], Z[t] + K, X[columns[t]]);
+    }
+    for (int i = rank; i < N; ++i) {
+      for (int j = 0; j < K; ++j) {
+        if (Y[i][j] != 0) return std::pair(false, X);
+      }
+    }
+    return std::pair(true, X);
   }
 
-  // Time complexity: O(nullity * NM).
+  // Time complexity: O(nullity * rank * M).
   std::vector<std::vector<T>> kernel_basis() const {
     std::vector<std::vector<T>> basis;
-    std::vector<T> e(M);
+    std::vector<T> zero(rank);
     for (int j = 0; j < M; ++j) {
       if (pivot[j] != -1) continue;
-      e[j] = 1;
-      auto y = solve(A * e, true).second;
-      e[j] = 0, y[j] = -1;
-      basis.push_back(y);
+      std::vector<T> x(M);
+      x[j] = -1;
+      back_substitute(zero, x);
+      basis.push_back(x);
     }
     return basis;
   }
 
+  // Inverts U row by row from the bottom, keeping the transpose W of the result so every entry is a contiguous dot
+  // product. Then solves X L = U^-1 column by column from the right in place, and finally permutes the columns.
   // Time complexity: O(N^3).
   Matrix<T> inverse() const {
     assert(N == M);
     assert(rank == N);
-    Matrix<T> res;
-    std::vector<T> e(N);
+    auto X = LU;
+    DenseMatrix<T> W(N, N);
+    for (int i = N - 1; i >= 0; --i) {
+      W[i][i] = inv_pivot[i];
+      for (int j = i + 1; j < N; ++j) {
+        W[j][i] = -inv_pivot[i] * MatrixMultiplication<T>::dot(X[i] + i + 1, W[j] + i + 1, j - i);
+      }
+    }
+    for (int i = 0; i < N; ++i) {
+      for (int j = i; j < N; ++j) {
+        X[i][j] = W[j][i];
+      }
+    }
+    std::vector<T> l(N);
+    for (int j = N - 2; j >= 0; --j) {
+      for (int k = j + 1; k < N; ++k) {
+        l[k] = X[k][j];
+        X[k][j] = 0;
+      }
+      for (int i = 0; i < N; ++i) {
+        X[i][j] -= MatrixMultiplication<T>::dot(X[i] + j + 1, l.data() + j + 1, N - j - 1);
+      }
+    }
+    Matrix<T> res(N, std::vector<T>(N));
     for (int i = 0; i < N; ++i) {
-      e[i] = 1;
-      auto x = solve(e).second;
-      for (int j = 0; j < N; ++j) {
-        res[j][i] = x[j];
+      for (int t = 0; t < N; ++t) {
+        res[i][perm[t]] = X[i][t];
       }
-      e[i] = 0;
     }
     return res;
   }
+
+  // Sets x[columns[t]] for t < rank from U x = y, given the other entries of x.
+  void back_substitute(const std::vector<T>& y, std::vector<T>& x) const {
+    for (int t = rank - 1; t >= 0; --t) {
+      int c = columns[t];
+      T s = y[t] - MatrixMultiplication<T>::dot(LU[t] + c + 1, x.data() + c + 1, M - c - 1);
+      x[c] = s * inv_pivot[t];
+    }
+  }
 };
 
 #endif  // ALGORITHMS_MATHEMATICS_GAUSSIAN_ELIMINATION_HPP
@@ -15,10 +15,10 @@ T interpolate(const std::vector<T>& y, T x) {
   for (int i = N - 1; i > 0; --i) {
     suff[i - 1] = suff[i] * (x - i);
   }
-  const auto& C = combinatorics<T>;
+  using C = Combinatorics<T>;
   T res = 0;
   for (int i = 0, sgn = (N % 2 ? +1 : -1); i < N; ++i, sgn *= -1) {
-    res += y[i] * sgn * pref[i] * suff[i] * C.rfact[i] * C.rfact[N - 1 - i];
+    res += y[i] * sgn * pref[i] * suff[i] * C::rf(i) * C::rf(N - 1 - i);
   }
   return res;
 }
@@ -1,6 +1,11 @@
 #ifndef ALGORITHMS_MATHEMATICS_LINEAR_RECURRENCE_HPP
 #define ALGORITHMS_MATHEMATICS_LINEAR_RECURRENCE_HPP
 
+#include "algorithms/mathematics/formal_power_series"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -22,6 +27,125 @@ T one_coeff(std::vector<T> p, std::vector<T> q, long long n) {
   return p[0] / q[0];
 }
 
+// Returns [x^n[i]] p / q for every i.
+template <typename T>
+std::vector<T> one_coeff(const std::vector<T>& p, const std::vector<T>& q, const std::vector<long long>& n) {
+  std::vector<T> res(n.size());
+  for (int i = 0; i < n.size(); ++i) {
+    res[i] = one_coeff(p, q, n[i]);
+  }
+  return res;
+}
+
+namespace linear_recurrence_auxiliary {
+
+// Returns p, q with p / q the generating function of u.
+template <typename T>
+std::pair<std::vector<T>, std::vector<T>> generating_function(const std::vector<T>& c, std::vector<T> u) {
+  u.resize(c.size());
+  int d = c.size();
+  std::vector<T> q(d + 1, 0);
+  q[0] = 1;
+  for (int i = 0; i < d; ++i) q[i + 1] -= c[i];
+  auto p = u * q;
+  p.resize(d);
+  return std::pair(std::move(p), std::move(q));
+}
+
+// The denominators q_0 = q and q_{k + 1}(x^2) = q_k(x) q_k(-x) met while halving n, each found on first use.
+// Z<ntt_mod> reads them off BostanMori's chain instead, see linear_recurrence_zp.
+template <typename T>
+struct DenominatorChain {
+  std::vector<std::vector<T>> q;
+
+  explicit DenominatorChain(std::vector<T> q0) : q{std::move(q0)} {}
+
+  const std::vector<T>& operator[](int k) {
+    while (q.size() <= k) {
+      const auto& Q = q.back();
+      int d = Q.size() - 1;
+      auto qneg = Q;
+      for (int i = 1; i <= d; i += 2) {
+        qneg[i] = -qneg[i];
+      }
+      auto w = Q * qneg;
+      std::vector<T> v(d + 1);
+      for (int i = 0; i <= d; ++i) {
+        v[i] = w[2 * i];
+      }
+      q.push_back(std::move(v));
+    }
+    return q[k];
+  }
+};
+
+// Returns [x^m, x^{m + L}) of 1 / q_k, where negative powers have coefficient 0.
+// Uses 1 / q_k(x) = q_k(-x) / q_{k + 1}(x^2), so each step halves m and costs one product of size L + d.
+template <typename T, typename Chain>
+std::vector<T> inverse_window(Chain& chain, int k, long long m, int L) {
+  using F = FormalPowerSeries<T>;
+  std::vector<T> q = chain[k];
+  int d = q.size() - 1;
+  if (m < L) {
+    if (m + L <= 0) {
+      return std::vector<T>(L);
+    }
+    F Q(q.begin(), q.end());
+    Q.resize(m + L);
+    auto R = inv(Q);
+    std::vector<T> res(L);
+    for (int j = std::max(0LL, -m); j < L; ++j) {
+      res[j] = R[m + j];
+    }
+    return res;
+  }
+  F qneg(q.begin(), q.end());
+  for (int i = 1; i <= d; i += 2) {
+    qneg[i] = -qneg[i];
+  }
+  long long base = m - d, lo = (base + 1) >> 1, hi = (m + L - 1) >> 1;
+  auto S = inverse_window<T>(chain, k + 1, lo, hi - lo + 1);
+  F E(L + d);
+  for (long long y = lo; y <= hi; ++y) {
+    E[2 * y - base] = S[y - lo];
+  }
+  auto C = qneg * E;
+  return std::vector<T>(C.begin() + d, C.begin() + d + L);
+}
+
+}  // namespace linear_recurrence_auxiliary
+
+// Returns [x^n, x^{n + k}) of p / q, assuming deg(p) < deg(q) when k > deg(q).
+// Finds the first deg(q) coefficients from a window of 1 / q, walking down the same chain of denominators as one_coeff,
+// and expands the rest through one series division.
+// Time complexity: O(convolution(d) * log(n) + convolution(k)).
+template <typename T>
+std::vector<T> coeff_window(const std::vector<T>& p, const std::vector<T>& q, long long n, int k) {
+  using F = FormalPowerSeries<T>;
+  assert(!q.empty() && q[0] != 0);
+  if (k == 0) {
+    return {};
+  } else if (p.empty()) {
+    return std::vector<T>(k);
+  }
+  int d = q.size() - 1, P = p.size(), w = std::min(k, std::max(d, 1));
+  linear_recurrence_auxiliary::DenominatorChain<T> chain(q);
+  auto a = linear_recurrence_auxiliary::inverse_window<T>(chain, 0, n - (P - 1), w + P - 1);
+  auto b = F(p.begin(), p.end()) * F(a.begin(), a.end());
+  F head(b.begin() + P - 1, b.begin() + P - 1 + w);
+  if (k == w) {
+    return head;
+  }
+  assert(P <= d);
+  F Q(q.begin(), q.end());
+  auto R = head * Q;
+  R.resize(d);
+  Q.resize(k);
+  auto res = R * inv(Q);
+  res.resize(k);
+  return res;
+}
+
 // Given the linear recurrence u[i+1] = c[0]u[i] + ... + c[d-1]u[i - (d - 1)] and the initial values u[0], ..., u[d-1],
 // finds u[n].
 // Time complexity: O(convolution(d) * log(n)).
@@ -33,14 +157,50 @@ T solve_linear_recurrence(std::vector<T> c, std::vector<T> u, long long n) {
   } else if (c.empty()) {
     return 0;
   }
-  u.resize(c.size());
-  int d = c.size(); 
-  std::vector<T> q(d + 1, 0);
-  q[0] = 1;
-  for (int i = 0; i < d; ++i) q[i + 1] -= c[i];
-  auto p = u * q;
-  p.resize(d);
+  auto [p, q] = linear_recurrence_auxiliary::generating_function(c, std::move(u));
   return one_coeff(p, q, n);
 }
 
+// Same as above for many n at once.
+template <typename T>
+std::vector<T> solve_linear_recurrence(std::vector<T> c, std::vector<T> u, const std::vector<long long>& n) {
+  assert(c.size() <= u.size());
+  std::vector<T> res(n.size());
+  std::vector<long long> large;
+  std::vector<int> idx;
+  for (int i = 0; i < n.size(); ++i) {
+    if (n[i] < u.size()) {
+      res[i] = u[n[i]];
+    } else if (!c.empty()) {
+      large.push_back(n[i]);
+      idx.push_back(i);
+    }
+  }
+  if (large.empty()) {
+    return res;
+  }
+  auto [p, q] = linear_recurrence_auxiliary::generating_function(c, std::move(u));
+  auto y = one_coeff(p, q, large);
+  for (int j = 0; j < idx.size(); ++j) {
+    res[idx[j]] = y[j];
+  }
+  return res;
+}
+
+// Returns u[n], ..., u[n + k - 1].
+// Time complexity: O(convolution(d) * log(n) + convolution(k)).
+template <typename T>
+std::vector<T> solve_linear_recurrence(std::vector<T> c, std::vector<T> u, long long n, int k) {
+  assert(c.size() <= u.size());
+  std::vector<T> res(k);
+  if (!c.empty()) {
+    auto [p, q] = linear_recurrence_auxiliary::generating_function(c, u);
+    res = coeff_window(p, q, n, k);
+  }
+  for (int j = 0; j < k && n + j < u.size(); ++j) {
+    res[j] = u[n + j];
+  }
+  return res;
+}
+
 #endif  // ALGORITHMS_MATHEMATICS_LINEAR_RECURRENCE_HPP
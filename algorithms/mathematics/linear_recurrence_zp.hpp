@@ -0,0 +1,164 @@
+#ifndef ALGORITHMS_MATHEMATICS_LINEAR_RECURRENCE_ZP_HPP
+#define ALGORITHMS_MATHEMATICS_LINEAR_RECURRENCE_ZP_HPP
+
+#include "algorithms/mathematics/convolution_zp"
+#include "algorithms/mathematics/fft"
+#include "algorithms/mathematics/linear_recurrence"
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+// Bostan-Mori kept in the frequency domain: p and q live as their values at the K-th roots of unity, q(-x) is a
+// rotation of those values and the even and odd parts are read off directly, so each bit costs four transforms of
+// length K / 2 instead of two full convolutions. The chain q, q(x)q(-x), ... does not depend on n, so it is computed
+// once and shared by every query, and queries agreeing on their lowest bits also share the steps for those bits.
+struct BostanMori {
+  using T = Z<ntt_mod>;
+
+  int K, H;
+  T p0;
+  std::vector<T> phat, w, odd;
+  std::deque<std::vector<T>> qhat;
+  std::vector<T> qconst;
+
+  BostanMori(std::vector<T> p, std::vector<T> q) : p0(p.empty() ? T(0) : p[0]) {
+    assert(!q.empty() && q[0] != 0);
+    K = 2;
+    while (K < 2 * std::max(p.size(), q.size())) K <<= 1;
+    H = K / 2;
+    qconst.push_back(q[0]);
+    p.resize(K);
+    q.resize(K);
+    phat = FFT<T>::dft(std::move(p));
+    qhat.push_back(FFT<T>::dft(std::move(q)));
+    T omega = RootOfUnity<T>::root_of_unity(K), inv2 = T(1) / T(2), inv_omega = 1 / omega;
+    w.resize(H);
+    odd.resize(H);
+    w[0] = 1, odd[0] = inv2;
+    for (int i = 1; i < H; ++i) {
+      w[i] = w[i - 1] * omega;
+      odd[i] = odd[i - 1] * inv_omega;
+    }
+  }
+
+  // Given the values at the (K/2)-th roots of unity of a polynomial of degree < K / 2, returns its values at the K-th
+  // roots of unity.
+  std::vector<T> extend(std::vector<T> f) const {
+    auto g = FFT<T>::idft(f);
+    for (int j = 0; j < H; ++j) {
+      g[j] *= w[j];
+    }
+    g = FFT<T>::dft(std::move(g));
+    f.resize(K);
+    for (int i = H - 1; i >= 0; --i) {
+      f[2 * i + 1] = g[i];
+      f[2 * i] = f[i];
+    }
+    return f;
+  }
+
+  const std::vector<T>& q_at(int k) {
+    while (qhat.size() <= k) {
+      const auto& Q = qhat.back();
+      std::vector<T> V(H);
+      for (int i = 0; i < H; ++i) {
+        V[i] = Q[i] * Q[i + H];
+      }
+      qhat.push_back(extend(std::move(V)));
+      qconst.push_back(qconst.back() * qconst.back());
+    }
+    return qhat[k];
+  }
+
+  // Returns [x^n[i]] p / q for every i.
+  std::vector<T> query(const std::vector<long long>& n) {
+    std::vector<T> res(n.size());
+    std::vector<std::pair<long long, int>> items;
+    for (int i = 0; i < n.size(); ++i) {
+      if (n[i] == 0) {
+        res[i] = p0 / qconst[0];
+      } else {
+        items.emplace_back(n[i], i);
+      }
+    }
+    if (!items.empty()) {
+      solve(phat, 0, items, res);
+    }
+    return res;
+  }
+
+  void solve(const std::vector<T>& P, int k, const std::vector<std::pair<long long, int>>& items, std::vector<T>& res) {
+    const auto& Q = q_at(k);
+    T scale = 1 / (T(H) * qconst[k] * qconst[k]);
+    for (int b : {0, 1}) {
+      std::vector<std::pair<long long, int>> next;
+      for (auto [n, i] : items) {
+        if ((n & 1) == b) {
+          next.emplace_back(n >> 1, i);
+        }
+      }
+      if (next.empty()) continue;
+      std::vector<T> U(H);
+      for (int i = 0; i < H; ++i) {
+        T x = P[i] * Q[i + H], y = P[i + H] * Q[i];
+        U[i] = b ? (x - y) * odd[i] : (x + y) * odd[0];
+      }
+      std::vector<std::pair<long long, int>> rest;
+      T constant = 0;
+      for (auto u : U) constant += u;
+      constant *= scale;
+      for (auto [n, i] : next) {
+        if (n == 0) {
+          res[i] = constant;
+        } else {
+          rest.emplace_back(n, i);
+        }
+      }
+      if (!rest.empty()) {
+        solve(extend(std::move(U)), k + 1, rest, res);
+      }
+    }
+  }
+};
+
+template <>
+inline Z<ntt_mod> one_coeff(std::vector<Z<ntt_mod>> p, std::vector<Z<ntt_mod>> q, long long n) {
+  return BostanMori(std::move(p), std::move(q)).query({n})[0];
+}
+
+// Only the denominator chain and the steps for common lowest bits are shared. The numerator at step k depends on the
+// lowest k bits of n, so queries that differ there each pay for the rest of their steps, and a batch of unrelated n
+// costs nearly as much as the queries one by one, less the chain.
+template <>
+inline std::vector<Z<ntt_mod>> one_coeff(const std::vector<Z<ntt_mod>>& p, const std::vector<Z<ntt_mod>>& q,
+                                         const std::vector<long long>& n) {
+  return BostanMori(p, q).query(n);
+}
+
+namespace linear_recurrence_auxiliary {
+
+// The chain is BostanMori's, computed in the frequency domain, and each q_k is interpolated back once.
+template <>
+struct DenominatorChain<Z<ntt_mod>> {
+  using T = Z<ntt_mod>;
+
+  int d;
+  BostanMori B;
+  std::vector<std::vector<T>> q;
+
+  explicit DenominatorChain(std::vector<T> q0) : d(q0.size() - 1), B({}, std::move(q0)) {}
+
+  const std::vector<T>& operator[](int k) {
+    while (q.size() <= k) {
+      auto c = FFT<T>::idft(B.q_at(q.size()));
+      c.resize(d + 1);
+      q.push_back(std::move(c));
+    }
+    return q[k];
+  }
+};
+
+}  // namespace linear_recurrence_auxiliary
+
+#endif  // ALGORITHMS_MATHEMATICS_LINEAR_RECURRENCE_ZP_HPP
@@ -1,6 +1,7 @@
 #ifndef ALGORITHMS_MATHEMATICS_MATRIX_HPP
 #define ALGORITHMS_MATHEMATICS_MATRIX_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -9,7 +10,7 @@ using Matrix = std::vector<std::vector<T>>;
 
 template <typename T>
 Matrix<T> zero(int N, int M) {
-  return Matrix<T>(N, std::vector<T>(N));
+  return Matrix<T>(N, std::vector<T>(M));
 }
 
 template <typename T>
@@ -30,7 +31,7 @@ template <typename T>
 Matrix<T> operator*(const Matrix<T>& A, const Matrix<T>& B) {
   int N = A.size(), M = A[0].size(), K = B[0].size();
   assert(M == B.size());
-  Matrix<T> C(N, std::vector<T>(M));
+  Matrix<T> C(N, std::vector<T>(K));
   for (int i = 0; i < N; ++i) {
     for (int j = 0; j < K; ++j) {
       for (int k = 0; k < M; ++k) {
@@ -67,4 +68,151 @@ Matrix<T> pow(Matrix<T> A, long long n) {
   return res;
 }
 
+// Row-major matrix in a single buffer, entry (i, j) at i * M + j.
+template <typename T>
+struct DenseMatrix {
+  int N, M;
+  std::vector<T> a;
+
+  explicit DenseMatrix(int N_ = 0, int M_ = 0) : N(N_), M(M_), a(N_ * M_) {}
+
+  DenseMatrix(const Matrix<T>& A) : DenseMatrix(A.size(), A.empty() ? 0 : A[0].size()) {
+    for (int i = 0; i < N; ++i) {
+      std::copy(A[i].begin(), A[i].end(), (*this)[i]);
+    }
+  }
+
+  operator Matrix<T>() const {
+    Matrix<T> A(N);
+    for (int i = 0; i < N; ++i) {
+      A[i].assign((*this)[i], (*this)[i] + M);
+    }
+    return A;
+  }
+
+  static DenseMatrix identity(int N) {
+    DenseMatrix I(N, N);
+    for (int i = 0; i < N; ++i) {
+      I[i][i] = 1;
+    }
+    return I;
+  }
+
+  T* operator[](int i) {
+    return a.data() + i * M;
+  }
+
+  const T* operator[](int i) const {
+    return a.data() + i * M;
+  }
+
+  DenseMatrix transpose() const {
+    constexpr int block_size = 32;
+    DenseMatrix B(M, N);
+    for (int i0 = 0; i0 < N; i0 += block_size) {
+      for (int j0 = 0; j0 < M; j0 += block_size) {
+        for (int i = i0; i < std::min(N, i0 + block_size); ++i) {
+          for (int j = j0; j < std::min(M, j0 + block_size); ++j) {
+            B[j][i] = (*this)[i][j];
+          }
+        }
+      }
+    }
+    return B;
+  }
+};
+
+// Inner kernels of the products below, specialized for types that can defer work across the sum.
+template <typename T>
+struct MatrixMultiplication {
+  // Returns a[0] * b[0] + ... + a[K - 1] * b[K - 1].
+  static T dot(const T* a, const T* b, int K) {
+    T res = 0;
+    for (int k = 0; k < K; ++k) {
+      res += a[k] * b[k];
+    }
+    return res;
+  }
+
+  // Sets res[2 * r + s] to the dot product of a[r] and b[s] for r, s < 2, which loads each entry once for two products.
+  static void dot(const T* const a[2], const T* const b[2], int K, T res[4]) {
+    T s00 = 0, s01 = 0, s10 = 0, s11 = 0;
+    for (int k = 0; k < K; ++k) {
+      s00 += a[0][k] * b[0][k], s01 += a[0][k] * b[1][k];
+      s10 += a[1][k] * b[0][k], s11 += a[1][k] * b[1][k];
+    }
+    res[0] = s00, res[1] = s01, res[2] = s10, res[3] = s11;
+  }
+};
+
+// Multiplies by rows of the transpose of B, in tiles of tile_size x tile_size entries of the result and slices of
+// depth columns of A so the rows involved stay in cache, and within a tile two rows by two columns at a time.
+// Time complexity: O(NMK).
+template <typename T>
+DenseMatrix<T> operator*(const DenseMatrix<T>& A, const DenseMatrix<T>& B) {
+  using K = MatrixMultiplication<T>;
+  constexpr int tile_size = 64, depth = 1024;
+  assert(A.M == B.N);
+  int N = A.N, M = B.M;
+  auto Bt = B.transpose();
+  DenseMatrix<T> C(N, M);
+  for (int k0 = 0; k0 < A.M; k0 += depth) {
+    int d = std::min(A.M, k0 + depth) - k0;
+    for (int i0 = 0; i0 < N; i0 += tile_size) {
+      int i1 = std::min(N, i0 + tile_size);
+      for (int j0 = 0; j0 < M; j0 += tile_size) {
+        int j1 = std::min(M, j0 + tile_size);
+        for (int i = i0; i < i1; i += 2) {
+          if (i + 1 == i1) {
+            for (int j = j0; j < j1; ++j) {
+              C[i][j] += K::dot(A[i] + k0, Bt[j] + k0, d);
+            }
+            break;
+          }
+          const T* a[2] = {A[i] + k0, A[i + 1] + k0};
+          for (int j = j0; j < j1; j += 2) {
+            if (j + 1 == j1) {
+              C[i][j] += K::dot(a[0], Bt[j] + k0, d);
+              C[i + 1][j] += K::dot(a[1], Bt[j] + k0, d);
+              break;
+            }
+            const T* b[2] = {Bt[j] + k0, Bt[j + 1] + k0};
+            T res[4];
+            K::dot(a, b, d, res);
+            C[i][j] += res[0], C[i][j + 1] += res[1];
+            C[i + 1][j] += res[2], C[i + 1][j + 1] += res[3];
+          }
+        }
+      }
+    }
+  }
+  return C;
+}
+
+template <typename T>
+std::vector<T> operator*(const DenseMatrix<T>& A, const std::vector<T>& b) {
+  assert(A.M == b.size());
+  std::vector<T> y(A.N);
+  for (int i = 0; i < A.N; ++i) {
+    y[i] = MatrixMultiplication<T>::dot(A[i], b.data(), A.M);
+  }
+  return y;
+}
+
+template <typename T>
+DenseMatrix<T> pow(DenseMatrix<T> A, long long n) {
+  assert(A.N == A.M);
+  auto res = DenseMatrix<T>::identity(A.N);
+  while (n) {
+    if (n & 1) {
+      res = A * res;
+    }
+    n >>= 1;
+    if (n) {
+      A = A * A;
+    }
+  }
+  return res;
+}
+
 #endif  // ALGORITHMS_MATHEMATICS_MATRIX_HPP
@@ -0,0 +1,96 @@
+#ifndef ALGORITHMS_MATHEMATICS_MATRIX_MOD_HPP
+#define ALGORITHMS_MATHEMATICS_MATRIX_MOD_HPP
+
+#include "algorithms/mathematics/matrix"
+#include "algorithms/mathematics/modular_arithmetic"
+
+#include <algorithm>
+
+template <unsigned P>
+struct MatrixMultiplication<Z<P>> {
+  using u64 = unsigned long long;
+
+  // Products are summed in 64-bit lanes and folded back with 2^32 = c (mod P) every chunk of them, which keeps the
+  // lanes below 2^64 with no division until the end. When P is too large for that, each product is reduced.
+  static constexpr int lanes = 4;
+  static constexpr u64 c = (1ULL << 32) % P;
+  static constexpr u64 fold_bound = 0xffffffffULL * c + 0xffffffffULL;
+  static constexpr u64 chunk = (~0ULL - fold_bound) / ((u64)(P - 1) * (P - 1));
+
+  static u64 fold(u64 x) {
+    return (x >> 32) * c + (x & 0xffffffffULL);
+  }
+
+  static Z<P> dot(const Z<P>* a, const Z<P>* b, int K) {
+    u64 s = 0;
+    int k = 0;
+    if constexpr (chunk > 0) {
+      u64 acc[2 * lanes] = {};
+      while (k + 2 * lanes <= K) {
+        int end = std::min<u64>(K - 2 * lanes + 1, k + chunk * 2 * lanes);
+        for (; k < end; k += 2 * lanes) {
+          for (int l = 0; l < 2 * lanes; ++l) {
+            acc[l] += (u64)a[k + l].value * b[k + l].value;
+          }
+        }
+        for (int l = 0; l < 2 * lanes; ++l) {
+          acc[l] = fold(acc[l]);
+        }
+      }
+      for (int l = 0; l < 2 * lanes; ++l) {
+        s += acc[l] % P;
+      }
+    }
+    for (; k < K; ++k) {
+      s += (u64)a[k].value * b[k].value % P;
+    }
+    return Z<P>(s % P);
+  }
+
+  static void dot(const Z<P>* const a[2], const Z<P>* const b[2], int K, Z<P> res[4]) {
+    u64 out[4];
+    sum(a, b, K, out);
+    for (int t = 0; t < 4; ++t) {
+      res[t] = Z<P>(out[t]);
+    }
+  }
+
+  // Sets out[2 * r + s] to the dot product of a[r] and b[s], reduced mod P.
+  static void sum(const Z<P>* const a[2], const Z<P>* const b[2], int K, u64 out[4]) {
+    std::fill(out, out + 4, 0);
+    int k = 0;
+    if constexpr (chunk > 0) {
+      u64 acc[4][lanes] = {};
+      while (k + lanes <= K) {
+        int end = std::min<u64>(K - lanes + 1, k + chunk * lanes);
+        for (; k < end; k += lanes) {
+          for (int l = 0; l < lanes; ++l) {
+            u64 x0 = a[0][k + l].value, x1 = a[1][k + l].value, y0 = b[0][k + l].value, y1 = b[1][k + l].value;
+            acc[0][l] += x0 * y0, acc[1][l] += x0 * y1;
+            acc[2][l] += x1 * y0, acc[3][l] += x1 * y1;
+          }
+        }
+        for (int t = 0; t < 4; ++t) {
+          for (int l = 0; l < lanes; ++l) {
+            acc[t][l] = fold(acc[t][l]);
+          }
+        }
+      }
+      for (int t = 0; t < 4; ++t) {
+        for (int l = 0; l < lanes; ++l) {
+          out[t] += acc[t][l] % P;
+        }
+      }
+    }
+    for (; k < K; ++k) {
+      u64 x0 = a[0][k].value, x1 = a[1][k].value, y0 = b[0][k].value, y1 = b[1][k].value;
+      out[0] += x0 * y0 % P, out[1] += x0 * y1 % P;
+      out[2] += x1 * y0 % P, out[3] += x1 * y1 % P;
+    }
+    for (int t = 0; t < 4; ++t) {
+      out[t] %= P;
+    }
+  }
+};
+
+#endif  // ALGORITHMS_MATHEMATICS_MATRIX_MOD_HPP
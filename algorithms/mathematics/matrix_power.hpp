@@ -0,0 +1,41 @@
+#ifndef ALGORITHMS_MATHEMATICS_MATRIX_POWER_HPP
+#define ALGORITHMS_MATHEMATICS_MATRIX_POWER_HPP
+
+#include "algorithms/mathematics/characteristic_polynomial"
+#include "algorithms/mathematics/matrix"
+#include "algorithms/mathematics/polynomial_modulus"
+
+#include <cassert>
+#include <vector>
+
+// Returns A^n v. By Cayley-Hamilton A^n = r(A) for r = x^n mod det(xI - A), which is evaluated on v by Horner's rule.
+// Time complexity: O(N^3 + convolution(N) * log(n)).
+template <typename T>
+std::vector<T> apply_power(const DenseMatrix<T>& A, long long n, std::vector<T> v) {
+  assert(A.N == A.M && A.N == v.size() && n >= 0);
+  int N = A.N;
+  if (n <= N) {
+    for (long long i = 0; i < n; ++i) {
+      v = A * v;
+    }
+    return v;
+  }
+  auto p = characteristic_polynomial<T>(A);
+  PolynomialModulus<T> mod(FormalPowerSeries<T>(p.begin(), p.end()));
+  auto r = mod.powmod({0, 1}, n);
+  std::vector<T> res(N);
+  for (int i = N - 1; i >= 0; --i) {
+    res = A * res;
+    for (int j = 0; j < N; ++j) {
+      res[j] += r[i] * v[j];
+    }
+  }
+  return res;
+}
+
+template <typename T>
+std::vector<T> apply_power(const Matrix<T>& A, long long n, std::vector<T> v) {
+  return apply_power(DenseMatrix<T>(A), n, std::move(v));
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_MATRIX_POWER_HPP
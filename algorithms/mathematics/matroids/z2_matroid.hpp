@@ -3,33 +3,37 @@
 
 #include "algorithms/mathematics/z2_gaussian_elimination"
 
+#include <cassert>
 #include <vector>
 
-// Needs Z2GaussianElimination.
-template <int N>
+// Element u is row u of matrix. The vectors of I are the columns of the system, so a solution gives the coefficients
+// of a vector over I.
 struct Z2Matroid {
-  std::vector<std::bitset<N>> matrix;
+  Z2Matrix matrix;
   std::vector<int> idx;
-  Z2GaussianElimination<N> basis;
+  Z2GaussianElimination basis;
 
-  Z2Matroid(const std::vector<std::bitset<N>> matrix) : matrix(matrix), idx(matrix.size()) {}
+  Z2Matroid(const Z2Matrix& matrix) : matrix(matrix), idx(matrix.N), basis(Z2Matrix()) {}
 
   void build(const std::vector<int>& I) {
-    basis = Z2GaussianElimination<N>();
-    int rk = 0;
-    for (auto u : I) {
-      assert(basis.insert(matrix[u]));
-      idx[u] = rk++;
+    Z2Matrix A(matrix.M, I.size());
+    for (int k = 0; k < I.size(); ++k) {
+      for (int j = 0; j < matrix.M; ++j) {
+        if (matrix.get(I[k], j)) A.flip(j, k);
+      }
+      idx[I[k]] = k;
     }
+    basis = Z2GaussianElimination(A);
+    assert(basis.rank == I.size());
   }
 
   bool oracle(int u) const {
-    return !basis.solve(matrix[u]).first;
+    return !basis.solve(matrix.row(u)).first;
   }
 
   bool oracle(int u, int v) const {
-    auto [good, coef] = basis.solve(matrix[v]);
-    return !good || coef[idx[u]];
+    auto [good, coef] = basis.solve(matrix.row(v));
+    return !good || z2_matrix_auxiliary::get(coef.data(), idx[u]);
   }
 };
 
@@ -1,8 +1,11 @@
 #ifndef ALGORITHMS_MATHEMATICS_MODULAR_ARITHMETIC_HPP
 #define ALGORITHMS_MATHEMATICS_MODULAR_ARITHMETIC_HPP
 
+#include <cassert>
 #include <iostream>
+#include <iterator>
 #include <type_traits>
+#include <vector>
 
 template <unsigned P>
 struct Z {
@@ -76,4 +79,27 @@ Z<P> pow(Z<P> x, long long p) {
   return res;
 }
 
+// Replaces each element of [first, last) by its inverse, none of them being 0. By Montgomery's trick only the product
+// of all of them is inverted, and every inverse follows from it and the prefix products.
+// Time complexity: O(N) multiplications and a single inversion.
+template <typename Iterator>
+void batch_inverse(Iterator first, Iterator last) {
+  using T = typename std::iterator_traits<Iterator>::value_type;
+  int N = last - first;
+  if (N == 0) return;
+  std::vector<T> prefix(N);
+  prefix[0] = first[0];
+  for (int i = 1; i < N; ++i) {
+    prefix[i] = prefix[i - 1] * first[i];
+  }
+  assert(prefix[N - 1] != 0);
+  T inv = 1 / prefix[N - 1];
+  for (int i = N - 1; i > 0; --i) {
+    T x = first[i];
+    first[i] = inv * prefix[i - 1];
+    inv *= x;
+  }
+  first[0] = inv;
+}
+
 #endif  // ALGORITHMS_MATHEMATICS_MODULAR_ARITHMETIC_HPP
@@ -0,0 +1,63 @@
+#ifndef ALGORITHMS_MATHEMATICS_MONTGOMERY_HPP
+#define ALGORITHMS_MATHEMATICS_MONTGOMERY_HPP
+
+#include <cassert>
+
+// Arithmetic modulo a runtime odd n < 2^64. Values are kept in Montgomery form x R mod n with R = 2^64, so that a
+// product needs two 64 x 64 -> 128 bit multiplications and no division.
+struct Montgomery {
+  using u64 = unsigned long long;
+  using u128 = unsigned __int128;
+
+  u64 n, n_inverse, r2;  // n * n_inverse = 1 mod R and r2 = R^2 mod n
+
+  explicit Montgomery(u64 n_) : n(n_), n_inverse(n_) {
+    assert(n & 1);
+    // Each step doubles the number of correct low bits, starting from 3 since n * n = 1 mod 8.
+    for (int i = 0; i < 5; ++i) {
+      n_inverse *= 2 - n * n_inverse;
+    }
+    u64 r = -n % n;
+    r2 = (u128)r * r % n;
+  }
+
+  // Returns t / R mod n, for t < nR.
+  u64 reduce(u128 t) const {
+    u64 m = (u64)t * n_inverse, h = (u128)m * n >> 64, high = t >> 64;
+    return high >= h ? high - h : high - h + n;
+  }
+
+  u64 transform(u64 x) const {
+    return reduce((u128)(x % n) * r2);
+  }
+
+  u64 value(u64 x) const {
+    return reduce(x);
+  }
+
+  u64 one() const {
+    return transform(1);
+  }
+
+  u64 add(u64 a, u64 b) const {
+    return a >= n - b ? a - (n - b) : a + b;
+  }
+
+  u64 sub(u64 a, u64 b) const {
+    return a >= b ? a - b : a + (n - b);
+  }
+
+  u64 mul(u64 a, u64 b) const {
+    return reduce((u128)a * b);
+  }
+
+  u64 pow(u64 a, u64 k) const {
+    u64 res = one();
+    for (; k; k >>= 1, a = mul(a, a)) {
+      if (k & 1) res = mul(res, a);
+    }
+    return res;
+  }
+};
+
+#endif  // ALGORITHMS_MATHEMATICS_MONTGOMERY_HPP
@@ -0,0 +1,42 @@
+#ifndef ALGORITHMS_MATHEMATICS_MULTIPLICATIVE_SUM_HPP
+#define ALGORITHMS_MATHEMATICS_MULTIPLICATIVE_SUM_HPP
+
+#include "algorithms/mathematics/prime_count"
+#include "algorithms/mathematics/sieve"
+
+#include <vector>
+
+// Returns f(1) + ... + f(n) for a multiplicative f with f(p) = c[0] + c[1] p + ... + c[d] p^d on primes and
+// f(p^k) = f_prime_power(p, k). This is Min_25's sieve: sums of p^i over the primes up to each value of n / m are
+// found first, and f is then summed by the smallest prime factor, recursing on the rest.
+// Time complexity: O(d * n^(3/4) / log(n)) for the prime sums, and about the same for the rest when n <= 10^13.
+template <typename T, typename Function>
+T multiplicative_sum(long long n, const std::vector<T>& c, Function f_prime_power) {
+  if (n < 1) return 0;
+  FloorValues F(n);
+  auto primes = Sieve(F.s).primes;
+  int d = c.size();
+  // G[t] is the sum of f(p) over the primes p <= w[t].
+  std::vector<T> G(F.W);
+  for (int i = 0; i < d; ++i) {
+    auto g = prime_power_sums<T>(F, i);
+    for (int t = 0; t < F.W; ++t) {
+      G[t] += c[i] * g[t];
+    }
+  }
+  // Sum of f(m) over 2 <= m <= x with no prime factor below primes[j].
+  auto sum = [&](auto& self, long long x, int j) -> T {
+    if (j < primes.size() && primes[j] > x) return 0;
+    T res = G[F.index(x)] - (j > 0 ? G[F.index(primes[j - 1])] : T(0));
+    for (int k = j; k < primes.size() && (long long)primes[k] * primes[k] <= x; ++k) {
+      long long p = primes[k], q = p;
+      for (int e = 1; q * p <= x; ++e, q *= p) {
+        res += f_prime_power(p, e) * self(self, x / q, k + 1) + f_prime_power(p, e + 1);
+      }
+    }
+    return res;
+  };
+  return sum(sum, n, 0) + 1;
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_MULTIPLICATIVE_SUM_HPP
@@ -1,8 +1,17 @@
 #ifndef ALGORITHMS_MATHEMATICS_POINTWISE_HPP
 #define ALGORITHMS_MATHEMATICS_POINTWISE_HPP
 
+#include "algorithms/mathematics/convolution_base"
+#include "algorithms/mathematics/factorization"
+
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 template <typename T, int K>
 struct Pointwise : public std::array<T, K> {
@@ -46,4 +55,387 @@ struct Pointwise : public std::array<T, K> {
   }
 };
 
+// A sequence of Pointwise<T, K> stored lane by lane, so that lane j of every element is the plain vector lanes[j].
+// Products are then K independent convolutions of std::vector<T>, with no transposition in between.
+template <typename T, int K>
+struct PointwiseVector {
+  using P = Pointwise<T, K>;
+  using V = PointwiseVector;
+
+  std::array<std::vector<T>, K> lanes;
+
+  explicit PointwiseVector(int N = 0) {
+    resize(N);
+  }
+
+  explicit PointwiseVector(const std::vector<P>& a) : PointwiseVector(a.size()) {
+    for (int i = 0; i < a.size(); ++i) {
+      set(i, a[i]);
+    }
+  }
+
+  int size() const {
+    return lanes[0].size();
+  }
+
+  void resize(int N) {
+    for (auto& lane : lanes) {
+      lane.resize(N);
+    }
+  }
+
+  P get(int i) const {
+    P res;
+    for (int j = 0; j < K; ++j) {
+      res[j] = lanes[j][i];
+    }
+    return res;
+  }
+
+  void set(int i, const P& x) {
+    for (int j = 0; j < K; ++j) {
+      lanes[j][i] = x[j];
+    }
+  }
+
+  std::vector<P> to_vector() const {
+    std::vector<P> res(size());
+    for (int i = 0; i < size(); ++i) {
+      res[i] = get(i);
+    }
+    return res;
+  }
+
+  V& operator+=(const V& rhs) {
+    if (size() < rhs.size()) resize(rhs.size());
+    for (int j = 0; j < K; ++j) {
+      for (int i = 0; i < rhs.size(); ++i) {
+        lanes[j][i] += rhs.lanes[j][i];
+      }
+    }
+    return *this;
+  }
+
+  V& operator-=(const V& rhs) {
+    if (size() < rhs.size()) resize(rhs.size());
+    for (int j = 0; j < K; ++j) {
+      for (int i = 0; i < rhs.size(); ++i) {
+        lanes[j][i] -= rhs.lanes[j][i];
+      }
+    }
+    return *this;
+  }
+
+  // Convolution, lane by lane.
+  friend V operator*(const V& lhs, const V& rhs) {
+    V res;
+    for (int j = 0; j < K; ++j) {
+      res.lanes[j] = lhs.lanes[j] * rhs.lanes[j];
+    }
+    return res;
+  }
+
+  friend V operator+(V lhs, const V& rhs) {
+    return lhs += rhs;
+  }
+
+  friend V operator-(V lhs, const V& rhs) {
+    return lhs -= rhs;
+  }
+};
+
+// Lane j of PointwiseZ<Ps...> is modulo the j-th of Ps, each an odd prime below 2^31. Residues are kept in Montgomery
+// form x 2^32 mod p, so that a product is three 32 x 32 -> 64 bit multiplications, which AVX2 does for 8 lanes at once.
+// With AVX2 the lanes are padded to a multiple of 8 with modulus 1, where every value is 0.
+namespace pointwise_auxiliary {
+
+#ifdef __AVX2__
+constexpr int lane_block = 8;
+#else
+constexpr int lane_block = 1;
+#endif
+
+template <int W>
+struct Moduli {
+  // p[j] * p_inverse[j] = 1 mod 2^32 and r2[j] = 2^64 mod p[j].
+  alignas(32) std::array<unsigned, W> p;
+  alignas(32) std::array<unsigned, W> p_inverse;
+  alignas(32) std::array<unsigned, W> r2;
+};
+
+template <int W, unsigned... Ps>
+constexpr Moduli<W> moduli() {
+  Moduli<W> res{};
+  unsigned ps[] = {Ps...};
+  for (int j = 0; j < W; ++j) {
+    unsigned p = j < sizeof...(Ps) ? ps[j] : 1, p_inverse = p, r = -p % p;
+    for (int i = 0; i < 4; ++i) {
+      p_inverse *= 2 - p * p_inverse;
+    }
+    res.p[j] = p, res.p_inverse[j] = p_inverse, res.r2[j] = (unsigned long long)r * r % p;
+  }
+  return res;
+}
+
+// Returns t / 2^32 mod p, for t < p 2^32.
+inline unsigned reduce(unsigned long long t, unsigned p, unsigned p_inverse) {
+  unsigned m = (unsigned)t * p_inverse, x = (t >> 32) - ((unsigned long long)m * p >> 32);
+  return std::min(x, x + p);
+}
+
+inline unsigned add(unsigned a, unsigned b, unsigned p) {
+  unsigned x = a + b;
+  return std::min(x, x - p);
+}
+
+inline unsigned sub(unsigned a, unsigned b, unsigned p) {
+  unsigned x = a - b;
+  return std::min(x, x + p);
+}
+
+inline unsigned mul(unsigned a, unsigned b, unsigned p, unsigned p_inverse) {
+  return reduce((unsigned long long)a * b, p, p_inverse);
+}
+
+#ifdef __AVX2__
+inline __m256i add(__m256i a, __m256i b, __m256i p) {
+  __m256i x = _mm256_add_epi32(a, b);
+  return _mm256_min_epu32(x, _mm256_sub_epi32(x, p));
+}
+
+inline __m256i sub(__m256i a, __m256i b, __m256i p) {
+  __m256i x = _mm256_sub_epi32(a, b);
+  return _mm256_min_epu32(x, _mm256_add_epi32(x, p));
+}
+
+// The even and odd lanes are reduced separately in 64-bit halves. The low words of t and m p agree, so t - m p holds
+// the difference of the high words in its high word.
+inline __m256i mul(__m256i a, __m256i b, __m256i p, __m256i p_inverse) {
+  __m256i p_odd = _mm256_srli_epi64(p, 32);
+  __m256i t0 = _mm256_mul_epu32(a, b);
+  __m256i t1 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  __m256i m0 = _mm256_mul_epu32(t0, p_inverse);
+  __m256i m1 = _mm256_mul_epu32(t1, _mm256_srli_epi64(p_inverse, 32));
+  __m256i x0 = _mm256_sub_epi64(t0, _mm256_mul_epu32(m0, p));
+  __m256i x1 = _mm256_sub_epi64(t1, _mm256_mul_epu32(m1, p_odd));
+  __m256i x = _mm256_blend_epi32(_mm256_srli_epi64(x0, 32), x1, 0b10101010);
+  return _mm256_min_epu32(x, _mm256_add_epi32(x, p));
+}
+
+inline __m256i load(const unsigned* a) {
+  return _mm256_load_si256((const __m256i*)a);
+}
+
+inline void store(unsigned* a, __m256i x) {
+  _mm256_store_si256((__m256i*)a, x);
+}
+#endif
+
+}  // namespace pointwise_auxiliary
+
+template <unsigned... Ps>
+struct PointwiseZ {
+  using P = PointwiseZ;
+  static constexpr int K = sizeof...(Ps);
+  static constexpr int W = (K + pointwise_auxiliary::lane_block - 1) / pointwise_auxiliary::lane_block *
+                           pointwise_auxiliary::lane_block;
+  static constexpr pointwise_auxiliary::Moduli<W> moduli = pointwise_auxiliary::moduli<W, Ps...>();
+  static_assert(((Ps % 2 == 1 && Ps < (1U << 31)) && ...));
+
+  alignas(32) std::array<unsigned, W> value{};
+
+  constexpr PointwiseZ() {}
+
+  template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+  PointwiseZ(T a) {
+    for (int j = 0; j < K; ++j) {
+      set(j, a);
+    }
+  }
+
+  // Returns lane j as a residue in [0, p).
+  unsigned get(int j) const {
+    return pointwise_auxiliary::reduce(value[j], moduli.p[j], moduli.p_inverse[j]);
+  }
+
+  void set(int j, long long a) {
+    long long p = moduli.p[j];
+    value[j] = pointwise_auxiliary::mul((a % p + p) % p, moduli.r2[j], p, moduli.p_inverse[j]);
+  }
+
+  P& operator+=(const P& rhs) {
+    namespace aux = pointwise_auxiliary;
+    int j = 0;
+#ifdef __AVX2__
+    for (; j < W; j += 8) {
+      aux::store(&value[j], aux::add(aux::load(&value[j]), aux::load(&rhs.value[j]), aux::load(&moduli.p[j])));
+    }
+#endif
+    for (; j < W; ++j) {
+      value[j] = aux::add(value[j], rhs.value[j], moduli.p[j]);
+    }
+    return *this;
+  }
+
+  P& operator-=(const P& rhs) {
+    namespace aux = pointwise_auxiliary;
+    int j = 0;
+#ifdef __AVX2__
+    for (; j < W; j += 8) {
+      aux::store(&value[j], aux::sub(aux::load(&value[j]), aux::load(&rhs.value[j]), aux::load(&moduli.p[j])));
+    }
+#endif
+    for (; j < W; ++j) {
+      value[j] = aux::sub(value[j], rhs.value[j], moduli.p[j]);
+    }
+    return *this;
+  }
+
+  P& operator*=(const P& rhs) {
+    namespace aux = pointwise_auxiliary;
+    int j = 0;
+#ifdef __AVX2__
+    for (; j < W; j += 8) {
+      aux::store(&value[j], aux::mul(aux::load(&value[j]), aux::load(&rhs.value[j]), aux::load(&moduli.p[j]),
+                                     aux::load(&moduli.p_inverse[j])));
+    }
+#endif
+    for (; j < W; ++j) {
+      value[j] = aux::mul(value[j], rhs.value[j], moduli.p[j], moduli.p_inverse[j]);
+    }
+    return *this;
+  }
+
+  // Every lane of the result is the inverse by Fermat's little theorem, each with its own exponent.
+  P inverse() const {
+    P res = 1;
+    for (int j = 0; j < K; ++j) {
+      unsigned p = moduli.p[j], p_inverse = moduli.p_inverse[j], x = value[j], &r = res.value[j];
+      for (unsigned e = p - 2; e; e >>= 1, x = pointwise_auxiliary::mul(x, x, p, p_inverse)) {
+        if (e & 1) r = pointwise_auxiliary::mul(r, x, p, p_inverse);
+      }
+    }
+    return res;
+  }
+
+  P& operator/=(const P& rhs) {
+    return *this *= rhs.inverse();
+  }
+
+  P operator+() const {
+    return *this;
+  }
+
+  P operator-() const {
+    return P() - *this;
+  }
+
+  bool operator==(const P& rhs) const {
+    return value == rhs.value;
+  }
+
+  bool operator!=(const P& rhs) const {
+    return value != rhs.value;
+  }
+
+  friend P operator+(P lhs, const P& rhs) {
+    return lhs += rhs;
+  }
+
+  friend P operator-(P lhs, const P& rhs) {
+    return lhs -= rhs;
+  }
+
+  friend P operator*(P lhs, const P& rhs) {
+    return lhs *= rhs;
+  }
+
+  friend P operator/(P lhs, const P& rhs) {
+    return lhs /= rhs;
+  }
+};
+
+// Multi-modulus convolution by a single NTT over all the lanes at once, so that each butterfly is one multiplication
+// of PointwiseZ. Every p - 1 must be divisible by the transform size.
+template <unsigned... Ps>
+struct Convolution<PointwiseZ<Ps...>> {
+  using P = PointwiseZ<Ps...>;
+  static constexpr int naive_threshold = 64;
+
+  // roots[b + i] = w^i for i < b, with w a primitive 2b-th root of unity in every lane.
+  static std::vector<P> roots(int N) {
+    static const unsigned long long g[] = {primitive_root(Ps)...};
+    std::vector<P> res(N);
+    for (int b = 1; b < N; b <<= 1) {
+      P w;
+      for (int j = 0; j < P::K; ++j) {
+        unsigned long long p = P::moduli.p[j], x = g[j], r = 1;
+        assert((p - 1) % (2 * b) == 0);
+        for (unsigned long long e = (p - 1) / (2 * b); e; e >>= 1, x = x * x % p) {
+          if (e & 1) r = r * x % p;
+        }
+        w.set(j, r);
+      }
+      res[b] = 1;
+      for (int i = 1; i < b; ++i) {
+        res[b + i] = res[b + i - 1] * w;
+      }
+    }
+    return res;
+  }
+
+  static void transform(std::vector<P>& a, const std::vector<P>& roots) {
+    int N = a.size();
+    for (int i = 1, j = 0; i < N; ++i) {
+      int bit = N >> 1;
+      for (; j & bit; bit >>= 1) {
+        j ^= bit;
+      }
+      j ^= bit;
+      if (i < j) std::swap(a[i], a[j]);
+    }
+    for (int b = 1; b < N; b <<= 1) {
+      for (int s = 0; s < N; s += 2 * b) {
+        for (int i = 0; i < b; ++i) {
+          P x = a[s + i], y = a[s + b + i] * roots[b + i];
+          a[s + i] = x + y;
+          a[s + b + i] = x - y;
+        }
+      }
+    }
+  }
+
+  static std::vector<P> convolution(std::vector<P> p, std::vector<P> q) {
+    int N = p.size(), M = q.size();
+    if (N == 0 || M == 0) {
+      return {};
+    } else if (std::min(N, M) <= naive_threshold) {
+      std::vector<P> res(N + M - 1);
+      for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < M; ++j) {
+          res[i + j] += p[i] * q[j];
+        }
+      }
+      return res;
+    } else {
+      int R = N + M - 1, K = 1;
+      while (K < R) K <<= 1;
+      p.resize(K);
+      q.resize(K);
+      auto w = roots(K);
+      transform(p, w);
+      transform(q, w);
+      P inv = P(K).inverse();
+      for (int i = 0; i < K; ++i) {
+        p[i] *= q[i] * inv;
+      }
+      // The inverse transform is the forward one read backwards.
+      transform(p, w);
+      std::reverse(p.begin() + 1, p.end());
+      p.resize(R);
+      return p;
+    }
+  }
+};
+
 #endif  // ALGORITHMS_MATHEMATICS_POINTWISE_HPP
@@ -0,0 +1,222 @@
+#ifndef ALGORITHMS_MATHEMATICS_POLYNOMIAL_GCD_HPP
+#define ALGORITHMS_MATHEMATICS_POLYNOMIAL_GCD_HPP
+
+#include "algorithms/mathematics/formal_power_series"
+
+#include <array>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+// Polynomials here are kept trimmed, so the zero polynomial is empty and the degree is size() - 1.
+namespace polynomial_gcd_auxiliary {
+
+constexpr int naive_threshold = 64;
+
+// [M[0] M[1]; M[2] M[3]] acting on column vectors (a, b).
+template <typename T>
+using Matrix = std::array<FormalPowerSeries<T>, 4>;
+
+template <typename T>
+Matrix<T> identity() {
+  return {FormalPowerSeries<T>{1}, FormalPowerSeries<T>(), FormalPowerSeries<T>(), FormalPowerSeries<T>{1}};
+}
+
+template <typename T>
+FormalPowerSeries<T> multiply(const FormalPowerSeries<T>& a, const FormalPowerSeries<T>& b) {
+  if (a.empty() || b.empty()) {
+    return {};
+  }
+  auto c = a * b;
+  c.trim_right();
+  return c;
+}
+
+template <typename T>
+FormalPowerSeries<T> shift(const FormalPowerSeries<T>& a, int k) {
+  return a.size() > k ? FormalPowerSeries<T>(a.begin() + k, a.end()) : FormalPowerSeries<T>();
+}
+
+template <typename T>
+Matrix<T> multiply(const Matrix<T>& A, const Matrix<T>& B) {
+  Matrix<T> C;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      C[2 * i + j] = multiply(A[2 * i], B[j]) + multiply(A[2 * i + 1], B[2 + j]);
+      C[2 * i + j].trim_right();
+    }
+  }
+  return C;
+}
+
+// Replaces (a, b) with M * (a, b).
+template <typename T>
+void apply(const Matrix<T>& M, FormalPowerSeries<T>& a, FormalPowerSeries<T>& b) {
+  FormalPowerSeries<T> c = multiply(M[0], a) + multiply(M[1], b);
+  b = multiply(M[2], a) + multiply(M[3], b);
+  a = std::move(c);
+  a.trim_right();
+  b.trim_right();
+}
+
+// One step of Euclid's algorithm, (a, b) -> (b, a mod b), recorded in M. The degree and leading coefficient of the
+// quotient are appended to quotients.
+template <typename T>
+void step(Matrix<T>& M, FormalPowerSeries<T>& a, FormalPowerSeries<T>& b, std::vector<std::pair<int, T>>& quotients) {
+  auto [q, r] = a.euclidean_division(b);
+  r.trim_right();
+  quotients.emplace_back(q.size() - 1, q.back());
+  FormalPowerSeries<T> c = M[0] - multiply(q, M[2]), d = M[1] - multiply(q, M[3]);
+  c.trim_right();
+  d.trim_right();
+  M[0] = std::move(M[2]), M[1] = std::move(M[3]);
+  M[2] = std::move(c), M[3] = std::move(d);
+  a = std::move(b), b = std::move(r);
+}
+
+// Returns M such that M * (a, b) are the first two consecutive remainders of Euclid's algorithm with
+// deg >= m > deg, where m = ceil(deg(a) / 2). Only the high halves of a and b are needed to find the quotients up to
+// that point, which gives the recursion. Requires deg(a) >= deg(b).
+// Time complexity: O(convolution(N) * log(N)).
+template <typename T>
+Matrix<T> half_gcd(FormalPowerSeries<T> a, FormalPowerSeries<T> b, std::vector<std::pair<int, T>>& quotients) {
+  int m = a.size() / 2;
+  auto M = identity<T>();
+  if (b.size() <= m) {
+    return M;
+  } else if (a.size() <= naive_threshold) {
+    while (b.size() > m) {
+      step(M, a, b, quotients);
+    }
+    return M;
+  }
+  M = half_gcd(shift(a, m), shift(b, m), quotients);
+  apply(M, a, b);
+  if (b.size() <= m) {
+    return M;
+  }
+  step(M, a, b, quotients);
+  if (b.size() <= m) {
+    return M;
+  }
+  int k = 2 * m - (a.size() - 1);
+  return multiply(half_gcd(shift(a, k), shift(b, k), quotients), M);
+}
+
+// Runs Euclid's algorithm to the end, leaving (gcd, 0) in (a, b) and multiplying the transformation into M if given.
+// Requires deg(a) >= deg(b).
+template <typename T>
+void euclid(FormalPowerSeries<T>& a, FormalPowerSeries<T>& b, std::vector<std::pair<int, T>>& quotients, Matrix<T>* M) {
+  while (!b.empty()) {
+    auto R = half_gcd(a, b, quotients);
+    apply(R, a, b);
+    if (!b.empty()) {
+      step(R, a, b, quotients);
+    }
+    if (M) {
+      *M = multiply(R, *M);
+    }
+  }
+}
+
+}  // namespace polynomial_gcd_auxiliary
+
+// Returns the monic greatest common divisor of a and b, or zero if both are zero.
+// Time complexity: O(convolution(N) * log(N)).
+template <typename T>
+FormalPowerSeries<T> gcd(FormalPowerSeries<T> a, FormalPowerSeries<T> b) {
+  namespace aux = polynomial_gcd_auxiliary;
+  a.trim_right();
+  b.trim_right();
+  if (a.size() < b.size()) {
+    std::swap(a, b);
+  }
+  std::vector<std::pair<int, T>> quotients;
+  aux::euclid(a, b, quotients, (aux::Matrix<T>*)nullptr);
+  if (!a.empty()) {
+    a /= T(a.back());
+  }
+  return a;
+}
+
+// Returns g = gcd(a, b) as above and sets x, y such that a * x + b * y = g. When neither a nor b divides the other,
+// deg(x) < deg(b) - deg(g) and deg(y) < deg(a) - deg(g).
+// Time complexity: O(convolution(N) * log(N)).
+template <typename T>
+FormalPowerSeries<T> extended_gcd(FormalPowerSeries<T> a, FormalPowerSeries<T> b, FormalPowerSeries<T>& x,
+                                  FormalPowerSeries<T>& y) {
+  namespace aux = polynomial_gcd_auxiliary;
+  a.trim_right();
+  b.trim_right();
+  bool swapped = a.size() < b.size();
+  if (swapped) {
+    std::swap(a, b);
+  }
+  std::vector<std::pair<int, T>> quotients;
+  auto M = aux::identity<T>();
+  aux::euclid(a, b, quotients, &M);
+  x = std::move(M[0]), y = std::move(M[1]);
+  if (!a.empty()) {
+    T c = 1 / a.back();
+    a *= c, x *= c, y *= c;
+  }
+  if (swapped) {
+    std::swap(x, y);
+  }
+  return a;
+}
+
+// Returns the inverse of a modulo m, which should be coprime to it, reduced to degree < deg(m).
+// Time complexity: O(convolution(N) * log(N)).
+template <typename T>
+FormalPowerSeries<T> inverse_mod(const FormalPowerSeries<T>& a, const FormalPowerSeries<T>& m) {
+  FormalPowerSeries<T> x, y;
+  auto g = extended_gcd(a, m, x, y);
+  assert(g.size() == 1);
+  return x;
+}
+
+// Returns the resultant of a and b, which is zero if either is zero. Only the degrees and leading coefficients of
+// the remainders are needed, and these follow from the quotients.
+// Time complexity: O(convolution(N) * log(N)).
+template <typename T>
+T resultant(FormalPowerSeries<T> a, FormalPowerSeries<T> b) {
+  namespace aux = polynomial_gcd_auxiliary;
+  a.trim_right();
+  b.trim_right();
+  if (a.empty() || b.empty()) {
+    return 0;
+  }
+  T res = 1;
+  if (a.size() < b.size()) {
+    if ((a.size() - 1) * (b.size() - 1) % 2) {
+      res = -res;
+    }
+    std::swap(a, b);
+  }
+  int n = a.size() - 1;
+  T l = a.back();
+  std::vector<std::pair<int, T>> quotients;
+  aux::euclid(a, b, quotients, (aux::Matrix<T>*)nullptr);
+  // Remainder i has degree degree[i] and leading coefficient lc[i], starting from a and b.
+  int K = quotients.size();
+  std::vector<int> degree(K + 1);
+  std::vector<T> lc(K + 1);
+  degree[0] = n, lc[0] = l;
+  for (int i = 0; i < K; ++i) {
+    degree[i + 1] = degree[i] - quotients[i].first;
+    lc[i + 1] = lc[i] / quotients[i].second;
+  }
+  if (degree[K] > 0) {
+    return 0;
+  }
+  for (int i = 1; i < K; ++i) {
+    if (degree[i - 1] % 2 && degree[i] % 2) {
+      res = -res;
+    }
+    res *= pow(lc[i], degree[i - 1] - degree[i + 1]);
+  }
+  return res * pow(lc[K], degree[K - 1]);
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_POLYNOMIAL_GCD_HPP
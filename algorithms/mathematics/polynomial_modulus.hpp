@@ -0,0 +1,121 @@
+#ifndef ALGORITHMS_MATHEMATICS_POLYNOMIAL_MODULUS_HPP
+#define ALGORITHMS_MATHEMATICS_POLYNOMIAL_MODULUS_HPP
+
+#include "algorithms/mathematics/formal_power_series"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace polynomial_modulus_auxiliary {
+
+// The two products of a reduction by f of degree d, given rinv, the inverse of the reversal of f modulo x^(d - 1).
+// Specialized where the transforms of f and rinv are worth caching, see polynomial_modulus_zp.
+template <typename T>
+struct ReductionProducts {
+  using F = FormalPowerSeries<T>;
+
+  ReductionProducts() {}
+
+  ReductionProducts(const F&, const F&, int) {}
+
+  // Returns the quotient of a by f, for d < a.size() <= 2d - 1.
+  F quotient(const F& a, const F& rinv, int d) const {
+    int K = a.size() - d;
+    auto q = F(a.rbegin(), a.rbegin() + K) * F(rinv.begin(), rinv.begin() + K);
+    q.resize(K);
+    std::reverse(q.begin(), q.end());
+    return q;
+  }
+
+  // Returns a - q * f, which has degree < d.
+  F remainder(const F& a, const F& q, const F& f, int d) const {
+    F r = a - q * f;
+    r.resize(d);
+    return r;
+  }
+};
+
+}  // namespace polynomial_modulus_auxiliary
+
+// Arithmetic modulo a fixed polynomial f of degree d. The inverse of the reversal of f is computed once, so a
+// reduction costs two products and a step of powmod about three. Residues always have exactly d coefficients.
+template <typename T>
+struct PolynomialModulus {
+  using F = FormalPowerSeries<T>;
+
+  int d;
+  F f, rinv;
+  polynomial_modulus_auxiliary::ReductionProducts<T> products;
+
+  PolynomialModulus(F f_) : f(std::move(f_)) {
+    f.trim_right();
+    assert(!f.empty());
+    d = f.size() - 1;
+    if (d >= 2) {
+      rinv = inv(F(f.rbegin(), f.rbegin() + d - 1));
+    }
+    products = polynomial_modulus_auxiliary::ReductionProducts<T>(f, rinv, d);
+  }
+
+  // Time complexity: O(convolution(a.size())).
+  F reduce(F a) const {
+    if (d == 0) {
+      return {};
+    } else if (d == 1) {
+      return {a(-f[0] / f[1])};
+    }
+    while (a.size() > 2 * d - 1) {
+      int t = a.size() - (2 * d - 1);
+      auto high = reduce(F(a.begin() + t, a.end()));
+      a.resize(t + d);
+      std::copy(high.begin(), high.end(), a.begin() + t);
+    }
+    if (a.size() <= d) {
+      a.resize(d);
+      return a;
+    }
+    return products.remainder(a, products.quotient(a, rinv, d), f, d);
+  }
+
+  F mulmod(const F& a, const F& b) const {
+    if (d == 0) {
+      return {};
+    }
+    return reduce(a * b);
+  }
+
+  // Returns g^n mod f.
+  // Time complexity: O(convolution(d) * log(n)).
+  F powmod(const F& g, long long n) const {
+    assert(n >= 0);
+    if (d == 0) {
+      return {};
+    }
+    bool is_x = g.size() == 2 && g[0] == 0 && g[1] == 1;
+    F res = reduce({1});
+    for (int b = 63 - __builtin_clzll(n | 1); b >= 0; --b) {
+      res = mulmod(res, res);
+      if (n >> b & 1) {
+        res = is_x ? multiply_by_x(std::move(res)) : mulmod(res, g);
+      }
+    }
+    return res;
+  }
+
+  // Time complexity: O(d).
+  F multiply_by_x(F a) const {
+    if (d == 0) {
+      return {};
+    }
+    T c = a[d - 1] / f[d];
+    for (int i = d - 1; i > 0; --i) {
+      a[i] = a[i - 1] - c * f[i];
+    }
+    a[0] = -c * f[0];
+    return a;
+  }
+};
+
+#endif  // ALGORITHMS_MATHEMATICS_POLYNOMIAL_MODULUS_HPP
@@ -0,0 +1,72 @@
+#ifndef ALGORITHMS_MATHEMATICS_POLYNOMIAL_MODULUS_ZP_HPP
+#define ALGORITHMS_MATHEMATICS_POLYNOMIAL_MODULUS_ZP_HPP
+
+#include "algorithms/mathematics/convolution_zp"
+#include "algorithms/mathematics/fft"
+#include "algorithms/mathematics/formal_power_series_zp"
+#include "algorithms/mathematics/polynomial_modulus"
+
+namespace polynomial_modulus_auxiliary {
+
+// For the NTT prime the transforms of f and rinv are cached, so each product of a reduction costs two transforms.
+// The product q * f only needs a cyclic convolution of length L >= d: the part that wraps onto the low d
+// coefficients agrees with a, so it is known.
+template <>
+struct ReductionProducts<Z<ntt_mod>> {
+  using T = Z<ntt_mod>;
+  using F = FormalPowerSeries<T>;
+
+  // Cyclic transforms of f and rinv of lengths L >= d and M >= 2d - 3.
+  int L = 0, M = 0;
+  std::vector<T> fhat, rinvhat;
+
+  ReductionProducts() {}
+
+  ReductionProducts(const F& f, const F& rinv, int d) {
+    if (d < 2) return;
+    L = M = 1;
+    while (L < d) L <<= 1;
+    while (M < 2 * d - 3) M <<= 1;
+    std::vector<T> p(L), q(M);
+    for (int i = 0; i <= d; ++i) {
+      p[i & (L - 1)] += f[i];
+    }
+    std::copy(rinv.begin(), rinv.end(), q.begin());
+    fhat = FFT<T>::dft(std::move(p));
+    rinvhat = FFT<T>::dft(std::move(q));
+  }
+
+  F quotient(const F& a, const F&, int d) const {
+    int K = a.size() - d;
+    std::vector<T> p(M);
+    std::copy_n(a.rbegin(), K, p.begin());
+    p = FFT<T>::dft(std::move(p));
+    for (int i = 0; i < M; ++i) {
+      p[i] *= rinvhat[i];
+    }
+    p = FFT<T>::idft(std::move(p));
+    F q(p.begin(), p.begin() + K);
+    std::reverse(q.begin(), q.end());
+    return q;
+  }
+
+  F remainder(const F& a, const F& q, const F&, int d) const {
+    std::vector<T> p(L);
+    std::copy(q.begin(), q.end(), p.begin());
+    p = FFT<T>::dft(std::move(p));
+    for (int i = 0; i < L; ++i) {
+      p[i] *= fhat[i];
+    }
+    p = FFT<T>::idft(std::move(p));
+    F r(d);
+    for (int i = 0; i < d; ++i) {
+      T high = i + L < a.size() ? a[i + L] : T(0);
+      r[i] = a[i] - (p[i] - high);
+    }
+    return r;
+  }
+};
+
+}  // namespace polynomial_modulus_auxiliary
+
+#endif  // ALGORITHMS_MATHEMATICS_POLYNOMIAL_MODULUS_ZP_HPP
@@ -0,0 +1,193 @@
+#ifndef ALGORITHMS_MATHEMATICS_PRIME_COUNT_HPP
+#define ALGORITHMS_MATHEMATICS_PRIME_COUNT_HPP
+
+#include "algorithms/mathematics/sieve"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// The values of n / m for 1 <= m <= n in decreasing order. The first L are n / (t + 1) and greater than s = sqrt(n),
+// and the rest are s, ..., 1.
+struct FloorValues {
+  long long n, s;
+  int W, L;
+  std::vector<long long> w;
+
+  explicit FloorValues(long long n_) : n(n_), s(std::sqrt((long double)n_)) {
+    while (s * s > n) --s;
+    while ((s + 1) * (s + 1) <= n) ++s;
+    for (long long m = 1; m <= n; m = n / (n / m) + 1) {
+      w.push_back(n / m);
+    }
+    W = w.size(), L = W - s;
+  }
+
+  int index(long long v) const {
+    return v <= s ? W - v : n / v - 1;
+  }
+};
+
+namespace prime_count_auxiliary {
+
+constexpr int parallel_threshold = 1 << 16;
+
+// C(m, j) for small j, with j! divided out of m (m - 1) ... (m - j + 1) exactly before multiplying in T.
+template <typename T>
+T binomial(long long m, int j, std::vector<long long>& a) {
+  a.resize(j);
+  for (int i = 0; i < j; ++i) {
+    a[i] = m - i;
+  }
+  for (int d = 2; d <= j; ++d) {
+    long long g = d;
+    for (auto& x : a) {
+      long long t = std::gcd(x, g);
+      x /= t, g /= t;
+    }
+  }
+  T res = 1;
+  for (auto x : a) {
+    res *= T(x);
+  }
+  return res;
+}
+
+// 2^k + ... + m^k for every m in w, as the sum over j of S(k, j) j! C(m + 1, j + 1) - [k = 0] - 1 with S the Stirling
+// numbers of the second kind, so that no division is done in T.
+template <typename T>
+std::vector<T> power_sums(const std::vector<long long>& w, int k) {
+  std::vector<long long> s = {1}, a;
+  for (int i = 1; i <= k; ++i) {
+    std::vector<long long> t(i + 1);
+    for (int j = 1; j <= i; ++j) {
+      t[j] = j * ((j < i ? s[j] : 0) + s[j - 1]);
+    }
+    s = t;
+  }
+  std::vector<T> res(w.size());
+  for (int t = 0; t < w.size(); ++t) {
+    res[t] = -T(k == 0) - 1;
+    for (int j = 0; j <= k; ++j) {
+      res[t] += T(s[j]) * binomial<T>(w[t] + 1, j + 1, a);
+    }
+  }
+  return res;
+}
+
+}  // namespace prime_count_auxiliary
+
+// Returns h with h[t] the sum of p^k over the primes p <= F.w[t], by Lucy_Hedgehog's method: starting from the sums
+// over all 2 <= m <= w[t], each prime p <= sqrt(n) in turn removes from every w[t] >= p^2 the multiples of p with no
+// smaller prime factor. For w[t] = n / (t + 1), n / ((t + 1)p) is read at index (t + 1)p - 1 while it is still above
+// sqrt(n), so only the values below it need a division. Large rounds are split over threads.
+// Time complexity: O(n^(3/4) / log(n)).
+template <typename T>
+std::vector<T> prime_power_sums(const FloorValues& F, int k,
+                                int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  namespace aux = prime_count_auxiliary;
+  auto h = aux::power_sums<T>(F.w, k);
+  std::vector<T> next;
+  for (long long p : primes_in_range(2, F.s + 1, 1)) {
+    T pk = 1;
+    for (int i = 0; i < k; ++i) {
+      pk *= T(p);
+    }
+    T below = h[F.W - (p - 1)];
+    int end = p * p > F.s ? F.n / (p * p) : F.W - p * p + 1, direct = F.L / p;
+    // Writes the new h[t] for a <= t < b to out[t]. Only entries after t are read, so out can be h.
+    auto update = [&](int a, int b, T* out) {
+      for (int t = a; t < std::min(b, direct); ++t) {
+        out[t] = h[t] - pk * (h[(t + 1) * p - 1] - below);
+      }
+      for (int t = std::max(a, direct); t < std::min(b, F.L); ++t) {
+        out[t] = h[t] - pk * (h[F.W - F.w[t] / p] - below);
+      }
+      for (int t = std::max(a, F.L); t < b; ++t) {
+        out[t] = h[t] - pk * (h[F.W - (unsigned)F.w[t] / (unsigned)p] - below);
+      }
+    };
+    if (threads == 1 || end < aux::parallel_threshold) {
+      update(0, end, h.data());
+      continue;
+    }
+    next.resize(end);
+    std::vector<std::future<void>> futures;
+    for (int i = 1; i < threads; ++i) {
+      futures.push_back(std::async(std::launch::async, update, (long long)end * i / threads,
+                                   (long long)end * (i + 1) / threads, next.data()));
+    }
+    update(0, end / threads, next.data());
+    for (auto& future : futures) {
+      future.get();
+    }
+    std::copy(next.begin(), next.begin() + end, h.begin());
+  }
+  return h;
+}
+
+// Returns the number of primes up to n. This is the table above for k = 0 specialized to the single value n, as in
+// Min_25's version: only odd numbers are kept, the values n / m are kept only for m with no prime factor removed yet,
+// and sieving stops at n^(1/4), the rest of the count being the pairs of larger primes found from the small table.
+// Time complexity: O(n^(3/4) / log(n)).
+inline long long prime_count(long long n) {
+  if (n < 2) return 0;
+  int v = std::sqrt((long double)n);
+  while ((long long)v * v > n) --v;
+  while ((long long)(v + 1) * (v + 1) <= n) ++v;
+  // small[i] counts the odd numbers in [3, 2i + 1], and large[k] those in [3, n / rough[k]], that remain.
+  int s = (v + 1) / 2, pc = 0;
+  std::vector<int> small(s), rough(s);
+  std::vector<long long> large(s);
+  std::vector<bool> skip(v + 1);
+  for (int i = 0; i < s; ++i) {
+    small[i] = i;
+    rough[i] = 2 * i + 1;
+    large[i] = (n / rough[i] - 1) / 2;
+  }
+  for (int p = 3; p <= v; p += 2) {
+    if (skip[p]) continue;
+    int q = p * p;
+    if ((long long)q * q > n) break;
+    skip[p] = true;
+    for (int i = q; i <= v; i += 2 * p) {
+      skip[i] = true;
+    }
+    int ns = 0;
+    for (int k = 0; k < s; ++k) {
+      int i = rough[k];
+      if (skip[i]) continue;
+      long long d = (long long)i * p;
+      large[ns] = large[k] - (d <= v ? large[small[d >> 1] - pc] : small[(n / d - 1) >> 1]) + pc;
+      rough[ns++] = i;
+    }
+    s = ns;
+    for (int i = (v - 1) >> 1, j = (v / p - 1) | 1; j >= p; j -= 2) {
+      int c = small[j >> 1] - pc;
+      for (int e = (j * p) >> 1; i >= e; --i) {
+        small[i] -= c;
+      }
+    }
+    ++pc;
+  }
+  large[0] += (long long)(s + 2 * (pc - 1)) * (s - 1) / 2;
+  for (int k = 1; k < s; ++k) {
+    large[0] -= large[k];
+  }
+  for (int l = 1; l < s; ++l) {
+    long long m = n / rough[l];
+    int e = small[(m / rough[l] - 1) >> 1] - pc;
+    if (e < l + 1) break;
+    long long t = 0;
+    for (int k = l + 1; k <= e; ++k) {
+      t += small[(m / rough[k] - 1) >> 1];
+    }
+    large[0] += t - (long long)(e - l) * (pc + l - 1);
+  }
+  return large[0] + 1;
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_PRIME_COUNT_HPP
@@ -1,8 +1,14 @@
 #ifndef ALGORITHMS_MATHEMATICS_SIEVE_HPP
 #define ALGORITHMS_MATHEMATICS_SIEVE_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
 #include <vector>
 
+// Linear sieve giving the smallest prime power of every integer up to N, for small N.
+
 struct Sieve {
   struct PrimePower {
     int p = -1, pow, k;  // pow = p^k
@@ -38,4 +44,146 @@ struct Sieve {
   }
 };
 
+namespace sieve_auxiliary {
+
+// Odd numbers only: bit i of a block starting at the odd number lo stands for lo + 2i, and is set when it is
+// composite. Blocks are sized for L2 and sieved in segments sized for L1.
+constexpr int segment_bits = 1 << 18, block_bits = 1 << 21;
+
+inline std::vector<int> odd_primes(int N) {
+  std::vector<bool> composite(N + 1);
+  std::vector<int> primes;
+  for (int i = 3; i <= N; i += 2) {
+    if (composite[i]) continue;
+    primes.push_back(i);
+    for (long long j = (long long)i * i; j <= N; j += 2 * i) {
+      composite[j] = true;
+    }
+  }
+  return primes;
+}
+
+// The multiples of the first few odd primes repeat with period 3 * 5 * 7 * 11 * 13 bits and are copied from a
+// pattern of 64 periods, so that any starting bit has a word-aligned copy.
+constexpr int presieved = 5, period = 15015;
+
+inline const std::vector<unsigned long long>& pattern() {
+  static const std::vector<unsigned long long> a = [] {
+    std::vector<unsigned long long> a(period);
+    for (int p : {3, 5, 7, 11, 13}) {
+      for (int i = p / 2; i < 64 * period; i += p) {
+        a[i >> 6] |= 1ULL << (i & 63);
+      }
+    }
+    return a;
+  }();
+  return a;
+}
+
+// Sieves the n odd numbers from lo with the odd primes up to sqrt(lo + 2n). next[j] is the index of the next multiple
+// of primes[j] to cross off, carried from one segment to the next.
+inline void sieve_block(long long lo, int n, const std::vector<int>& primes, std::vector<unsigned long long>& bits,
+                        std::vector<int>& next) {
+  long long hi = lo + 2LL * n;
+  int m = 0;
+  while (m < primes.size() && (long long)primes[m] * primes[m] < hi) {
+    long long p = primes[m], start = std::max(p * p, (lo + p - 1) / p * p);
+    if (start % 2 == 0) start += p;
+    next[m++] = std::min<long long>((start - lo) / 2, n);
+  }
+  bits.resize((n + 63) / 64);
+  unsigned long long* a = bits.data();
+  // Bit i stands for 2((lo - 1) / 2 + i) + 1, found in the pattern at any bit congruent to that modulo period.
+  int r = (lo - 1) / 2 % period;
+  while (r % 64) r += period;
+  for (int w = 0, k = r / 64; w < bits.size(); ++w, k = k + 1 == period ? 0 : k + 1) {
+    a[w] = pattern()[k];
+  }
+  for (int p : {3, 5, 7, 11, 13}) {
+    if (lo <= p && p < hi) a[(p - lo) / 2 >> 6] &= ~(1ULL << ((p - lo) / 2 & 63));
+  }
+  for (int s = 0; s < n; s += segment_bits) {
+    unsigned end = std::min(n, s + segment_bits);
+    for (int j = presieved; j < m; ++j) {
+      unsigned i = next[j], p = primes[j];
+      for (; i < end; i += p) {
+        a[i >> 6] |= 1ULL << (i & 63);
+      }
+      next[j] = i;
+    }
+  }
+  if (lo == 1) bits[0] |= 1;
+  if (n % 64) bits.back() |= ~0ULL << (n % 64);
+}
+
+// Calls f(lo, n, bits) for consecutive blocks covering the odd numbers in [L, R), in order and on this thread, while
+// up to threads blocks are sieved at a time.
+template <typename Function>
+void sieve_blocks(long long L, long long R, int threads, Function f) {
+  long long lo = std::max(L, 1LL) | 1;
+  if (lo >= R) return;
+  long long total = (R - lo + 1) / 2, blocks = (total + block_bits - 1) / block_bits;
+  long long r = std::sqrt((long double)R);
+  while (r * r >= R) --r;
+  while ((r + 1) * (r + 1) < R) ++r;
+  auto primes = odd_primes(r);
+  std::vector<std::vector<unsigned long long>> bits(threads);
+  std::vector<std::vector<int>> next(threads, std::vector<int>(primes.size()));
+  for (long long b0 = 0; b0 < blocks; b0 += threads) {
+    int k = std::min<long long>(threads, blocks - b0);
+    auto sieve = [&](int t) {
+      long long b = b0 + t;
+      sieve_block(lo + 2 * b * block_bits, std::min<long long>(block_bits, total - b * block_bits), primes, bits[t],
+                  next[t]);
+    };
+    std::vector<std::future<void>> futures;
+    for (int t = 1; t < k; ++t) {
+      futures.push_back(std::async(std::launch::async, sieve, t));
+    }
+    sieve(0);
+    for (auto& future : futures) {
+      future.get();
+    }
+    for (int t = 0; t < k; ++t) {
+      long long b = b0 + t;
+      f(lo + 2 * b * block_bits, std::min<long long>(block_bits, total - b * block_bits), bits[t]);
+    }
+  }
+}
+
+}  // namespace sieve_auxiliary
+
+// Calls f(p) for every prime p in [L, R) in increasing order, on this thread.
+// Time complexity: O((R - L) * log(log(R)) + sqrt(R) * (1 + (R - L) / block_bits)).
+template <typename Function>
+void for_each_prime(long long L, long long R, Function f,
+                    int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  if (L <= 2 && 2 < R) f(2LL);
+  sieve_auxiliary::sieve_blocks(L, R, threads, [&](long long lo, int, const std::vector<unsigned long long>& bits) {
+    for (int w = 0; w < bits.size(); ++w) {
+      for (unsigned long long x = ~bits[w]; x; x &= x - 1) {
+        f(lo + 2 * (64LL * w + __builtin_ctzll(x)));
+      }
+    }
+  });
+}
+
+inline std::vector<long long> primes_in_range(long long L, long long R,
+                                              int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  std::vector<long long> primes;
+  for_each_prime(L, R, [&](long long p) { primes.push_back(p); }, threads);
+  return primes;
+}
+
+inline long long count_primes_in_range(long long L, long long R,
+                                       int threads = std::max(1u, std::thread::hardware_concurrency())) {
+  long long count = L <= 2 && 2 < R;
+  sieve_auxiliary::sieve_blocks(L, R, threads, [&](long long, int, const std::vector<unsigned long long>& bits) {
+    for (auto x : bits) {
+      count += __builtin_popcountll(~x);
+    }
+  });
+  return count;
+}
+
 #endif  // ALGORITHMS_MATHEMATICS_SIEVE_HPP
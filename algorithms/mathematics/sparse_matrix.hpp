@@ -0,0 +1,71 @@
+#ifndef ALGORITHMS_MATHEMATICS_SPARSE_MATRIX_HPP
+#define ALGORITHMS_MATHEMATICS_SPARSE_MATRIX_HPP
+
+#include "algorithms/mathematics/modular_arithmetic"
+
+#include <cassert>
+#include <tuple>
+#include <vector>
+
+// Compressed sparse rows: the entries of row i are (index[k], value[k]) for start[i] <= k < start[i + 1].
+template <typename T>
+struct SparseMatrix {
+  int N, M;
+  std::vector<int> start, index;
+  std::vector<T> value;
+
+  // Entries are (row, column, value); repeated positions add up.
+  SparseMatrix(int N_, int M_, const std::vector<std::tuple<int, int, T>>& entries)
+      : N(N_), M(M_), start(N_ + 1), index(entries.size()), value(entries.size()) {
+    for (auto& [i, j, x] : entries) {
+      assert(0 <= i && i < N && 0 <= j && j < M);
+      ++start[i + 1];
+    }
+    for (int i = 0; i < N; ++i) {
+      start[i + 1] += start[i];
+    }
+    auto next = start;
+    for (auto& [i, j, x] : entries) {
+      index[next[i]] = j;
+      value[next[i]++] = x;
+    }
+  }
+
+  int non_zeros() const {
+    return value.size();
+  }
+};
+
+// Time complexity: O(N + non_zeros).
+template <typename T>
+std::vector<T> operator*(const SparseMatrix<T>& A, const std::vector<T>& b) {
+  assert(A.M == b.size());
+  std::vector<T> y(A.N);
+  for (int i = 0; i < A.N; ++i) {
+    T sum = 0;
+    for (int k = A.start[i]; k < A.start[i + 1]; ++k) {
+      sum += A.value[k] * b[A.index[k]];
+    }
+    y[i] = sum;
+  }
+  return y;
+}
+
+// Products are summed unreduced while they fit in 63 bits.
+template <unsigned P>
+std::vector<Z<P>> operator*(const SparseMatrix<Z<P>>& A, const std::vector<Z<P>>& b) {
+  static_assert(P < (1U << 31));
+  assert(A.M == b.size());
+  std::vector<Z<P>> y(A.N);
+  for (int i = 0; i < A.N; ++i) {
+    unsigned long long sum = 0;
+    for (int k = A.start[i]; k < A.start[i + 1]; ++k) {
+      sum += (unsigned long long)A.value[k].value * b[A.index[k]].value;
+      if (sum >> 63) sum %= P;
+    }
+    y[i] = Z<P>(sum % P);
+  }
+  return y;
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_SPARSE_MATRIX_HPP
@@ -0,0 +1,118 @@
+#ifndef ALGORITHMS_MATHEMATICS_WIEDEMANN_HPP
+#define ALGORITHMS_MATHEMATICS_WIEDEMANN_HPP
+
+#include "algorithms/mathematics/berlekamp_massey"
+#include "algorithms/mathematics/modular_arithmetic"
+#include "algorithms/mathematics/sparse_matrix"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Black-box methods that only multiply A by vectors. They are Monte Carlo, with failure probability about N / P per
+// attempt, so P should be large.
+namespace wiedemann_auxiliary {
+
+constexpr int attempts = 4;
+
+template <unsigned P>
+std::vector<Z<P>> random_vector(int N) {
+  thread_local std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+  std::uniform_int_distribution<unsigned> unif(1, P - 1);
+  std::vector<Z<P>> v(N);
+  for (auto& x : v) {
+    x = unif(rng);
+  }
+  return v;
+}
+
+template <unsigned P>
+Z<P> dot(const std::vector<Z<P>>& u, const std::vector<Z<P>>& v) {
+  Z<P> res = 0;
+  for (int i = 0; i < u.size(); ++i) {
+    res += u[i] * v[i];
+  }
+  return res;
+}
+
+}  // namespace wiedemann_auxiliary
+
+// With a random diagonal D, the minimal polynomial of u^T (AD)^i v for random u, v is the characteristic polynomial
+// of AD with high probability, and its constant term gives det(AD) = det(A) det(D). Returns false if every attempt
+// failed, and otherwise the determinant; a 0 is only returned once A is known to be singular.
+// Time complexity: O(N * non_zeros + convolution(N) * log(N)), with O(N + non_zeros) memory.
+template <unsigned P>
+std::pair<bool, Z<P>> wiedemann_determinant(const SparseMatrix<Z<P>>& A) {
+  namespace aux = wiedemann_auxiliary;
+  assert(A.N == A.M);
+  int N = A.N;
+  if (N == 0) return std::pair(true, Z<P>(1));
+  for (int attempt = 0; attempt < aux::attempts; ++attempt) {
+    auto d = aux::random_vector<P>(N), u = aux::random_vector<P>(N), v = aux::random_vector<P>(N);
+    std::vector<Z<P>> s(2 * N);
+    for (int i = 0; i < 2 * N; ++i) {
+      s[i] = aux::dot(u, v);
+      for (int j = 0; j < N; ++j) {
+        v[j] *= d[j];
+      }
+      v = A * v;
+    }
+    auto c = berlekamp_massey(s);
+    if (c.empty()) continue;
+    if (c.back() == 0) return std::pair(true, Z<P>(0));
+    if (c.size() < N) continue;
+    Z<P> det = N % 2 ? c.back() : -c.back(), scale = 1;
+    for (auto x : d) {
+      scale *= x;
+    }
+    return std::pair(true, det / scale);
+  }
+  return std::pair(false, Z<P>(0));
+}
+
+// Solves Ax = b for nonsingular A: if f is the minimal polynomial of u^T A^i b, f(A) b = 0 and x follows from
+// dividing f by its constant term. The solution is checked, so a returned one is always correct.
+// Time complexity: O(N * non_zeros + convolution(N) * log(N)), with O(N + non_zeros) memory.
+template <unsigned P>
+std::pair<bool, std::vector<Z<P>>> wiedemann_solve(const SparseMatrix<Z<P>>& A, const std::vector<Z<P>>& b) {
+  namespace aux = wiedemann_auxiliary;
+  assert(A.N == A.M && A.N == b.size());
+  int N = A.N;
+  for (int attempt = 0; attempt < aux::attempts; ++attempt) {
+    auto u = aux::random_vector<P>(N);
+    std::vector<Z<P>> s(2 * N), w = b;
+    for (int i = 0; i < 2 * N; ++i) {
+      s[i] = aux::dot(u, w);
+      w = A * w;
+    }
+    auto c = berlekamp_massey(s);
+    if (c.empty()) {
+      if (std::count(b.begin(), b.end(), Z<P>(0)) == N) {
+        return std::pair(true, std::vector<Z<P>>(N));
+      }
+      continue;
+    }
+    if (c.back() == 0) continue;
+    int L = c.size();
+    auto x = b;
+    for (int j = 0; j + 1 < L; ++j) {
+      x = A * x;
+      for (int i = 0; i < N; ++i) {
+        x[i] -= c[j] * b[i];
+      }
+    }
+    Z<P> inv = 1 / c.back();
+    for (auto& y : x) {
+      y *= inv;
+    }
+    if (A * x == b) {
+      return std::pair(true, x);
+    }
+  }
+  return std::pair(false, std::vector<Z<P>>());
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_WIEDEMANN_HPP
@@ -1,51 +1,127 @@
 #ifndef ALGORITHMS_MATHEMATICS_Z2_GAUSSIAN_ELIMINATION_HPP
 #define ALGORITHMS_MATHEMATICS_Z2_GAUSSIAN_ELIMINATION_HPP
 
-#include <bitset>
+#include "algorithms/mathematics/z2_matrix"
+
+#include <algorithm>
+#include <cassert>
 #include <utility>
+#include <vector>
 
-template <int N>
+// Reduced row echelon form of A together with the row operations giving it: R = [EA | E] for some invertible E, with
+// E starting at word offset of each row. The t-th pivot is at (t, columns[t]).
 struct Z2GaussianElimination {
-  using V = std::bitset<N>;
-  V basis[N], alpha[N];
-  int dim = 0, first[N];
+  static constexpr int table_bits = 8;
+
+  int N, M, offset;
+  Z2Matrix R;
+  std::vector<int> columns, pivot;
+  int rank, nullity;
 
-  std::pair<int, V> reduce(V& x) const {
-    V coef;
+  // Method of Four Russians. The pivots of a 64-column window are found by eliminating on that window of each row
+  // only, which costs a word per row and pivot. Only the pivot rows themselves are reduced in full; every other row
+  // then clears them with one lookup per table_bits pivots into the tables of all sums of those pivot rows, so the
+  // matrix is swept once per window.
+  // Time complexity: O(std::min(N, M)N(N + M) / (64 * table_bits)).
+  Z2GaussianElimination(const Z2Matrix& A) : N(A.N), M(A.M), offset(A.W), R(N, 64 * A.W + N), pivot(M, -1) {
+    namespace aux = z2_matrix_auxiliary;
     for (int i = 0; i < N; ++i) {
-      if (x[i] == 0) continue;
-      if (basis[i] == 0) return std::pair(i, coef);
-      x ^= basis[i], coef ^= alpha[i];
+      std::copy(A[i], A[i] + A.W, R[i]);
+      aux::flip(R[i] + offset, i);
     }
-    return std::pair(-1, coef);
-  }
-
-  bool insert(V x) {
-    auto [i, coef] = reduce(x);
-    if (i == -1) return false;
-    basis[i] = x;
-    alpha[i] = coef;
-    alpha[i][dim] = 1;
-    first[dim] = i;
-    ++dim;
-    return true;
+    std::vector<unsigned long long> window(N), table((64 << table_bits) / table_bits * R.W);
+    int row = 0;
+    for (int c0 = 0; c0 < M && row < N;) {
+      int w0 = c0 / 64, n = R.W - w0, r0 = row, c = c0;
+      for (int i = row; i < N; ++i) {
+        window[i] = R[i][w0] >> (c0 & 63);
+        if (c0 & 63) window[i] |= R[i][w0 + 1] << (64 - (c0 & 63));
+      }
+      for (; c < std::min(M, c0 + 64) && row < N; ++c) {
+        unsigned long long bit = 1ULL << (c - c0);
+        int sel = -1;
+        for (int i = row; i < N; ++i) {
+          if (window[i] & bit) {
+            sel = i;
+            break;
+          }
+        }
+        if (sel == -1) continue;
+        if (sel != row) {
+          std::swap(window[sel], window[row]);
+          std::swap_ranges(R[sel] + w0, R[sel] + R.W, R[row] + w0);
+        }
+        for (int t = r0; t < row; ++t) {
+          if (R.get(row, columns[t])) aux::add(R[row] + w0, R[t] + w0, n);
+        }
+        for (int t = r0; t < row; ++t) {
+          if (R.get(t, c)) aux::add(R[t] + w0, R[row] + w0, n);
+        }
+        for (int i = row + 1; i < N; ++i) {
+          if (window[i] & bit) window[i] ^= window[row];
+        }
+        columns.push_back(c);
+        pivot[c] = row++;
+      }
+      c0 = c;
+      int k = row - r0;
+      if (k == 0) continue;
+      // Table g holds the sums of pivots r0 + g * table_bits + t for t < table_bits.
+      int G = (k + table_bits - 1) / table_bits;
+      for (int g = 0; g < G; ++g) {
+        unsigned long long* T = table.data() + (g << table_bits) * n;
+        std::fill(T, T + n, 0);
+        for (int s = 1; s < 1 << std::min(table_bits, k - g * table_bits); ++s) {
+          int p = r0 + g * table_bits + __builtin_ctz(s);
+          std::copy(R[p] + w0, R[p] + R.W, T + s * n);
+          aux::add(T + s * n, T + (s & (s - 1)) * n, n);
+        }
+      }
+      for (int i = 0; i < N; ++i) {
+        if (i == r0) i = row;
+        if (i == N) break;
+        const unsigned long long* sums[64 / table_bits];
+        int h = 0;
+        for (int g = 0; g < G; ++g) {
+          int s = 0;
+          for (int t = 0; t < std::min(table_bits, k - g * table_bits); ++t) {
+            s |= R.get(i, columns[r0 + g * table_bits + t]) << t;
+          }
+          if (s) sums[h++] = table.data() + ((g << table_bits) + s) * n;
+        }
+        aux::add(R[i] + w0, sums, h, n);
+      }
+    }
+    rank = row, nullity = M - rank;
   }
 
-  std::pair<bool, V> solve(V x) const {
-    auto [i, coef] = reduce(x);
-    return std::pair(i == -1, coef);
+  // Time complexity: O(N^2 / 64 + M).
+  std::pair<bool, std::vector<unsigned long long>> solve(const std::vector<unsigned long long>& b) const {
+    namespace aux = z2_matrix_auxiliary;
+    assert(aux::words(N) == b.size());
+    std::vector<unsigned long long> x(aux::words(M));
+    for (int t = 0; t < N; ++t) {
+      if (!aux::dot(R[t] + offset, b.data(), b.size())) continue;
+      if (t >= rank) return std::pair(false, x);
+      aux::flip(x.data(), columns[t]);
+    }
+    return std::pair(true, x);
   }
 
-  void exchange(int r, V x) {
-    auto [k, coef] = reduce(x);
-    assert(k == -1);
-    assert(coef[r] == 1);
-    for (int i = 0; i < N; ++i) {
-      if (alpha[i][r]) {
-        alpha[i] ^= coef;
-        alpha[i][r] = 1;
+  // Time complexity: O(nullity * (rank + M / 64)).
+  std::vector<std::vector<unsigned long long>> kernel_basis() const {
+    namespace aux = z2_matrix_auxiliary;
+    std::vector<std::vector<unsigned long long>> basis;
+    for (int j = 0; j < M; ++j) {
+      if (pivot[j] != -1) continue;
+      std::vector<unsigned long long> x(aux::words(M));
+      aux::flip(x.data(), j);
+      for (int t = 0; t < rank; ++t) {
+        if (R.get(t, j)) aux::flip(x.data(), columns[t]);
       }
+      basis.push_back(x);
     }
+    return basis;
   }
 };
 
@@ -0,0 +1,123 @@
+#ifndef ALGORITHMS_MATHEMATICS_Z2_MATRIX_HPP
+#define ALGORITHMS_MATHEMATICS_Z2_MATRIX_HPP
+
+#include <cassert>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Vectors over Z2 are packed 64 to a word: bit j is bit j % 64 of word j / 64.
+namespace z2_matrix_auxiliary {
+
+inline int words(int n) {
+  return (n + 63) / 64;
+}
+
+inline bool get(const unsigned long long* a, int j) {
+  return a[j >> 6] >> (j & 63) & 1;
+}
+
+inline void flip(unsigned long long* a, int j) {
+  a[j >> 6] ^= 1ULL << (j & 63);
+}
+
+// a ^= b over n words.
+inline void add(unsigned long long* a, const unsigned long long* b, int n) {
+  int i = 0;
+#ifdef __AVX2__
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + i)), y = _mm256_loadu_si256((const __m256i*)(b + i));
+    _mm256_storeu_si256((__m256i*)(a + i), _mm256_xor_si256(x, y));
+  }
+#endif
+  for (; i < n; ++i) {
+    a[i] ^= b[i];
+  }
+}
+
+// a ^= b[0] ^ ... ^ b[k - 1] over n words, loading and storing a once.
+inline void add(unsigned long long* a, const unsigned long long* const* b, int k, int n) {
+  int i = 0;
+#ifdef __AVX2__
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    for (int j = 0; j < k; ++j) {
+      x = _mm256_xor_si256(x, _mm256_loadu_si256((const __m256i*)(b[j] + i)));
+    }
+    _mm256_storeu_si256((__m256i*)(a + i), x);
+  }
+#endif
+  for (; i < n; ++i) {
+    unsigned long long x = a[i];
+    for (int j = 0; j < k; ++j) {
+      x ^= b[j][i];
+    }
+    a[i] = x;
+  }
+}
+
+// Parity of the popcount of a & b over n words.
+inline bool dot(const unsigned long long* a, const unsigned long long* b, int n) {
+  unsigned long long s = 0;
+  for (int i = 0; i < n; ++i) {
+    s ^= a[i] & b[i];
+  }
+  return __builtin_parityll(s);
+}
+
+}  // namespace z2_matrix_auxiliary
+
+// N x M matrix over Z2, each row packed into W words.
+struct Z2Matrix {
+  int N, M, W;
+  std::vector<unsigned long long> a;
+
+  explicit Z2Matrix(int N_ = 0, int M_ = 0) : N(N_), M(M_), W(z2_matrix_auxiliary::words(M_)), a(N_ * W) {}
+
+  unsigned long long* operator[](int i) {
+    return a.data() + i * W;
+  }
+
+  const unsigned long long* operator[](int i) const {
+    return a.data() + i * W;
+  }
+
+  bool get(int i, int j) const {
+    return z2_matrix_auxiliary::get((*this)[i], j);
+  }
+
+  void flip(int i, int j) {
+    z2_matrix_auxiliary::flip((*this)[i], j);
+  }
+
+  void set(int i, int j, bool x) {
+    if (get(i, j) != x) flip(i, j);
+  }
+
+  std::vector<unsigned long long> row(int i) const {
+    return std::vector<unsigned long long>((*this)[i], (*this)[i] + W);
+  }
+
+  Z2Matrix transpose() const {
+    Z2Matrix B(M, N);
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < M; ++j) {
+        if (get(i, j)) B.flip(j, i);
+      }
+    }
+    return B;
+  }
+};
+
+// Time complexity: O(NM / 64).
+inline std::vector<unsigned long long> operator*(const Z2Matrix& A, const std::vector<unsigned long long>& b) {
+  assert(A.W == b.size());
+  std::vector<unsigned long long> y(z2_matrix_auxiliary::words(A.N));
+  for (int i = 0; i < A.N; ++i) {
+    if (z2_matrix_auxiliary::dot(A[i], b.data(), A.W)) z2_matrix_auxiliary::flip(y.data(), i);
+  }
+  return y;
+}
+
+#endif  // ALGORITHMS_MATHEMATICS_Z2_MATRIX_HPP